@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/AmmoLedger.h"
+
+FAmmoLedger::FAmmoLedger()
+{
+	for (int32 Index = 0; Index < NumTypes; ++Index)
+	{
+		Counts[Index] = 0;
+		Caps[Index] = DefaultCap;
+	}
+}
+
+int32 FAmmoLedger::Add(EAmmoType AmmoType, int32 Amount)
+{
+	if (!ensure(IsValidType(AmmoType)) || Amount <= 0)
+	{
+		return 0;
+	}
+
+	const int32 Index = (int32)AmmoType;
+	const int32 Previous = Counts[Index];
+	SetCount(Index, FMath::Min(Previous + Amount, Caps[Index]));
+	return Counts[Index] - Previous;
+}
+
+int32 FAmmoLedger::Remove(EAmmoType AmmoType, int32 Amount)
+{
+	if (!ensure(IsValidType(AmmoType)) || Amount <= 0)
+	{
+		return 0;
+	}
+
+	const int32 Index = (int32)AmmoType;
+	const int32 Removed = FMath::Min(Amount, Counts[Index]);
+	SetCount(Index, Counts[Index] - Removed);
+	return Removed;
+}
+
+void FAmmoLedger::Set(EAmmoType AmmoType, int32 Count)
+{
+	if (ensure(IsValidType(AmmoType)))
+	{
+		const int32 Index = (int32)AmmoType;
+		SetCount(Index, FMath::Clamp(Count, 0, Caps[Index]));
+	}
+}
+
+void FAmmoLedger::SetCap(EAmmoType AmmoType, int32 Cap)
+{
+	if (ensure(IsValidType(AmmoType)))
+	{
+		const int32 Index = (int32)AmmoType;
+		Caps[Index] = FMath::Max(Cap, 0);
+		SetCount(Index, FMath::Min(Counts[Index], Caps[Index]));
+	}
+}
+
+void FAmmoLedger::SetCount(int32 Index, int32 Count)
+{
+	if (Counts[Index] != Count)
+	{
+		Counts[Index] = Count;
+		ChangedMask |= 1u << Index;
+	}
+}
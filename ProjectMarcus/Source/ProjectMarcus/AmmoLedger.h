@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProjectMarcus/AmmoType.h"
+#include "AmmoLedger.generated.h"
+
+/**
+ * Ammo count for every EAmmoType, indexed directly by the enum (no hashing), each clamped to its own cap.
+ * Remembers which types changed so listeners (the HUD) only refresh those. Plain data, doesn't know about the
+ * character, so AI and save games can hold one too (counts and caps are SaveGame).
+ */
+USTRUCT(BlueprintType)
+struct PROJECTMARCUS_API FAmmoLedger
+{
+	GENERATED_BODY()
+
+	static constexpr int32 NumTypes = (int32)EAmmoType::EAT_Max;
+	static constexpr int32 DefaultCap = 999;
+
+	static_assert(NumTypes <= 32, "ChangedMask holds one bit per ammo type");
+
+	FAmmoLedger();
+
+	static bool IsValidType(EAmmoType AmmoType) { return (int32)AmmoType < NumTypes; }
+
+	int32 Get(EAmmoType AmmoType) const { return IsValidType(AmmoType) ? Counts[(int32)AmmoType] : 0; }
+
+	int32 GetCap(EAmmoType AmmoType) const { return IsValidType(AmmoType) ? Caps[(int32)AmmoType] : 0; }
+
+	bool Has(EAmmoType AmmoType) const { return Get(AmmoType) > 0; }
+
+	// Adds up to the cap, returns how much was actually added
+	int32 Add(EAmmoType AmmoType, int32 Amount);
+
+	// Removes what's there (at most Amount), returns how much was actually removed
+	int32 Remove(EAmmoType AmmoType, int32 Amount);
+
+	// Clamped to [0, cap]
+	void Set(EAmmoType AmmoType, int32 Count);
+
+	// Lowering the cap clamps the current count
+	void SetCap(EAmmoType AmmoType, int32 Cap);
+
+	bool IsChanged(EAmmoType AmmoType) const { return IsValidType(AmmoType) && (ChangedMask & (1u << (int32)AmmoType)) != 0; }
+
+	bool HasChanges() const { return ChangedMask != 0; }
+
+	// e.g. after loading, so everything listening refreshes
+	void MarkAllChanged() { ChangedMask = (NumTypes == 32) ? ~0u : ((1u << NumTypes) - 1); }
+
+	// Calls Func(EAmmoType, int32 Count) for each type changed since the last call, then clears them
+	template<typename FuncType>
+	void ConsumeChanges(FuncType&& Func)
+	{
+		uint32 Mask = ChangedMask;
+		ChangedMask = 0;
+		while (Mask != 0)
+		{
+			const int32 Index = FMath::CountTrailingZeros(Mask);
+			Mask &= Mask - 1;
+			Func((EAmmoType)Index, Counts[Index]);
+		}
+	}
+
+private:
+	void SetCount(int32 Index, int32 Count);
+
+	UPROPERTY(VisibleAnywhere, SaveGame, Category = "Ammo", meta = (ArraySizeEnum = "EAmmoType"))
+	int32 Counts[(int32)EAmmoType::EAT_Max];
+
+	UPROPERTY(EditAnywhere, SaveGame, Category = "Ammo", meta = (ArraySizeEnum = "EAmmoType", ClampMin = "0"))
+	int32 Caps[(int32)EAmmoType::EAT_Max];
+
+	// Bit per type whose count changed since the last ConsumeChanges
+	uint32 ChangedMask = 0;
+};
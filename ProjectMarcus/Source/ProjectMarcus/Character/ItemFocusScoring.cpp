@@ -0,0 +1,106 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Character/ItemFocusScoring.h"
+#include "ProjectMarcus/ProjectMarcus.h"
+#include "Math/VectorRegister.h"
+
+DECLARE_CYCLE_STAT(TEXT("Item Focus Scoring"), STAT_ItemFocusScoring, STATGROUP_ProjectMarcus);
+
+void FItemFocusCandidates::Reset()
+{
+	X.Reset();
+	Y.Reset();
+	Z.Reset();
+	NumCandidates = 0;
+}
+
+void FItemFocusCandidates::Add(const FVector& Location)
+{
+	X.Add(Location.X);
+	Y.Add(Location.Y);
+	Z.Add(Location.Z);
+	++NumCandidates;
+}
+
+void FItemFocusCandidates::Finalize()
+{
+	// Padding lanes are skipped by index in the kernel, this just keeps the loads in bounds
+	const int32 PaddedNum = Align(NumCandidates, 4);
+	X.SetNumZeroed(PaddedNum);
+	Y.SetNumZeroed(PaddedNum);
+	Z.SetNumZeroed(PaddedNum);
+}
+
+int32 ItemFocusScoring::FindBestCandidate(const FItemFocusCandidates& Candidates, const FItemFocusParams& Params)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ItemFocusScoring);
+
+	const int32 NumCandidates = Candidates.Num();
+	if (NumCandidates == 0)
+	{
+		return INDEX_NONE;
+	}
+	check(Candidates.NumPadded() % 4 == 0);
+
+	const VectorRegister OriginX = VectorSetFloat1(Params.ViewOrigin.X);
+	const VectorRegister OriginY = VectorSetFloat1(Params.ViewOrigin.Y);
+	const VectorRegister OriginZ = VectorSetFloat1(Params.ViewOrigin.Z);
+	const VectorRegister DirX = VectorSetFloat1(Params.ViewDir.X);
+	const VectorRegister DirY = VectorSetFloat1(Params.ViewDir.Y);
+	const VectorRegister DirZ = VectorSetFloat1(Params.ViewDir.Z);
+	const VectorRegister DistancePenalty = VectorSetFloat1(Params.DistanceWeight / FMath::Max(Params.MaxDistance, KINDA_SMALL_NUMBER));
+	const VectorRegister MinDistSq = VectorSetFloat1(KINDA_SMALL_NUMBER);
+
+	const float* RESTRICT XData = Candidates.X.GetData();
+	const float* RESTRICT YData = Candidates.Y.GetData();
+	const float* RESTRICT ZData = Candidates.Z.GetData();
+
+	alignas(16) float LookLanes[4];
+	alignas(16) float ScoreLanes[4];
+
+	int32 BestIndex = INDEX_NONE;
+	float BestScore = -MAX_FLT;
+
+	for (int32 Base = 0, End = Candidates.NumPadded(); Base < End; Base += 4)
+	{
+		const VectorRegister DX = VectorSubtract(VectorLoadAligned(XData + Base), OriginX);
+		const VectorRegister DY = VectorSubtract(VectorLoadAligned(YData + Base), OriginY);
+		const VectorRegister DZ = VectorSubtract(VectorLoadAligned(ZData + Base), OriginZ);
+
+		const VectorRegister DistSq = VectorMax(VectorMultiplyAdd(DX, DX, VectorMultiplyAdd(DY, DY, VectorMultiply(DZ, DZ))), MinDistSq);
+		const VectorRegister Dot = VectorMultiplyAdd(DX, DirX, VectorMultiplyAdd(DY, DirY, VectorMultiply(DZ, DirZ)));
+		const VectorRegister InvDist = VectorReciprocalSqrtAccurate(DistSq);
+
+		// cos(angle between view dir and dir to item) and the distance penalised score
+		const VectorRegister LookAmount = VectorMultiply(Dot, InvDist);
+		const VectorRegister Score = VectorSubtract(LookAmount, VectorMultiply(VectorMultiply(DistSq, InvDist), DistancePenalty));
+
+		VectorStoreAligned(LookAmount, LookLanes);
+		VectorStoreAligned(Score, ScoreLanes);
+
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			const int32 Index = Base + Lane;
+			if (Index >= NumCandidates)
+			{
+				break;
+			}
+
+			const bool bIsCurrentFocus = Index == Params.CurrentFocusIndex;
+			const float Threshold = bIsCurrentFocus ? Params.LookThreshold - Params.HysteresisBand : Params.LookThreshold;
+			if (LookLanes[Lane] < Threshold)
+			{
+				continue;
+			}
+
+			const float LaneScore = bIsCurrentFocus ? ScoreLanes[Lane] + Params.HysteresisBand : ScoreLanes[Lane];
+			if (LaneScore > BestScore)
+			{
+				BestScore = LaneScore;
+				BestIndex = Index;
+			}
+		}
+	}
+
+	return BestIndex;
+}
@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Structure-of-arrays copy of focus candidate locations.
+// Lanes are padded out to a multiple of 4 so the scoring kernel never needs a scalar tail loop
+struct PROJECTMARCUS_API FItemFocusCandidates
+{
+	void Reset();
+
+	void Add(const FVector& Location);
+
+	// Pads the lanes, must be called after the last Add and before scoring
+	void Finalize();
+
+	int32 Num() const { return NumCandidates; }
+
+	int32 NumPadded() const { return X.Num(); }
+
+	TArray<float, TAlignedHeapAllocator<16>> X;
+	TArray<float, TAlignedHeapAllocator<16>> Y;
+	TArray<float, TAlignedHeapAllocator<16>> Z;
+
+private:
+	int32 NumCandidates = 0;
+};
+
+struct FItemFocusParams
+{
+	// Where the crosshair ray starts in the world
+	FVector ViewOrigin = FVector::ZeroVector;
+
+	// Crosshair direction in the world (normalized)
+	FVector ViewDir = FVector::ForwardVector;
+
+	// How close the player needs to look at a candidate (1 = directly at it, 0.5 = 50% between looking and not...etc)
+	float LookThreshold = 0.99f;
+
+	// Distance penalty per unit of MaxDistance. Breaks ties between items lined up behind each other in favor of the closer one
+	float DistanceWeight = 0.005f;
+
+	// Distances are normalized against this before weighting
+	float MaxDistance = 1.f;
+
+	// The currently focused candidate keeps focus until it drops this far below LookThreshold, and a challenger has to beat it by this much
+	float HysteresisBand = 0.003f;
+
+	// Index of the currently focused candidate or INDEX_NONE
+	int32 CurrentFocusIndex = INDEX_NONE;
+};
+
+namespace ItemFocusScoring
+{
+	// Scores 4 candidates at a time and returns the index of the best one, or INDEX_NONE if nothing passes the look threshold
+	PROJECTMARCUS_API int32 FindBestCandidate(const FItemFocusCandidates& Candidates, const FItemFocusParams& Params);
+}
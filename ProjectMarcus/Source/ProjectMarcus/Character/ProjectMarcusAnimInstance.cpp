@@ -1,154 +1,185 @@
 #include "ProjectMarcus/Character/ProjectMarcusAnimInstance.h"
 #include "ProjectMarcus/Character/ProjectMarcusCharacter.h"
+#include "ProjectMarcus/ProjectMarcus.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/KismetMathLibrary.h"
 
-void UProjectMarcusAnimInstance::UpdateAnimationProperties(float DeltaTime)
+DECLARE_CYCLE_STAT(TEXT("Player Anim Proxy Update"), STAT_PlayerAnimProxyUpdate, STATGROUP_ProjectMarcus);
+
+const FName FProjectMarcusAnimInstanceProxy::TurningCurveName(TEXT("Turning"));
+const FName FProjectMarcusAnimInstanceProxy::RotationCurveName(TEXT("RotationV2"));
+
+void FProjectMarcusAnimInstanceProxy::Initialize(UAnimInstance* InAnimInstance)
 {
-	if (PMCharacter == nullptr)
+	FAnimInstanceProxy::Initialize(InAnimInstance);
+
+	MarcusInstance = Cast<UProjectMarcusAnimInstance>(InAnimInstance);
+}
+
+void FProjectMarcusAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
+{
+	FAnimInstanceProxy::PreUpdate(InAnimInstance, DeltaSeconds);
+
+	Snapshot.bValid = false;
+	if (MarcusInstance == nullptr)
 	{
-		FindOwner();
+		return;
 	}
 
-	if (PMCharacter)
+	if (MarcusInstance->PMCharacter == nullptr)
 	{
-		// Update FootSpeed based off the lateral speed of the character from velocity (disregard vertical movement)
-		FVector Velocity = PMCharacter->GetVelocity();
-		Velocity.Z = 0.f; // we only want the lateral component of velocity so that if the character is falling or moving in a vertical way it doesn't effect our speed
-		FootSpeed = Velocity.Size(); // the length of the velocity vector is the speed
+		MarcusInstance->FindOwner();
+	}
+
+	// Game thread, copy only. Everything derived from this happens in Update
+	if (AProjectMarcusCharacter* PMCharacter = MarcusInstance->PMCharacter)
+	{
+		Snapshot.Velocity = PMCharacter->GetVelocity();
+		Snapshot.AimRotation = PMCharacter->GetBaseAimRotation();
+		Snapshot.ActorYaw = PMCharacter->GetActorRotation().Yaw;
+		Snapshot.bIsAiming = PMCharacter->IsAiming();
+		Snapshot.bReloading = PMCharacter->GetCombatState() == ECombatState::ECS_Reloading;
 
-		// Check if the character is in the air
 		UCharacterMovementComponent* MoveComp = PMCharacter->GetCharacterMovement();
 		if (ensure(MoveComp))
 		{
-			bIsInAir = MoveComp->IsFalling();
-			bIsAccelerating = MoveComp->GetCurrentAcceleration().Size() > 0.f;
+			Snapshot.bIsFalling = MoveComp->IsFalling();
+			Snapshot.bIsAccelerating = MoveComp->GetCurrentAcceleration().Size() > 0.f;
 		}
+		Snapshot.bValid = true;
+	}
+}
 
-		
-		// What is the direction the controller is pointing in
-		FRotator AimRotation = PMCharacter->GetBaseAimRotation();
-		FRotator MovementRotation = UKismetMathLibrary::MakeRotFromX(PMCharacter->GetVelocity()); // rotation from the world X direction based on some direction vector
-		AimMovementDiff = UKismetMathLibrary::NormalizedDeltaRotator(MovementRotation, AimRotation).Yaw;
+void FProjectMarcusAnimInstanceProxy::Update(float DeltaSeconds)
+{
+	FAnimInstanceProxy::Update(DeltaSeconds);
 
-		// If we're moving, store the this frames movement so on the frame we stop moving, we know which direction we were headed to play the correct stop animation
-		if (PMCharacter->GetVelocity().Size() > 0.f)
-		{
-			LastAimMovementDiff = AimMovementDiff;
-		}
+	if (MarcusInstance == nullptr || !Snapshot.bValid)
+	{
+		return;
+	}
 
-		bIsAiming = PMCharacter->IsAiming();
+	SCOPE_CYCLE_COUNTER(STAT_PlayerAnimProxyUpdate);
 
-		// Check if we are reloading or not
-		bReloadingInProgress = PMCharacter->GetCombatState() == ECombatState::ECS_Reloading;
+	UProjectMarcusAnimInstance& Anim = *MarcusInstance;
 
-		// Order matters here.
-		if (bReloadingInProgress)
-		{
-			AimOffsetState = EAimOffsetState::EAOS_Reloading;
-		}
-		else if(bIsInAir)
-		{
-			AimOffsetState = EAimOffsetState::EAOS_InAir;
-		}
-		else if (bIsAiming)
-		{
-			AimOffsetState = EAimOffsetState::EAOS_ADS;
-		}
-		else
-		{
-			AimOffsetState = EAimOffsetState::EAOS_Hip;
-		}
-		
-		// TODO: Swap this out for MovementOffset once you figure out how to indicate between left and right when DOT is 0...
-		//FVector PlayerLookDir = PMCharacter->GetActorForwardVector().GetSafeNormal();
-		//FVector MovementDir = PMCharacter->GetVelocity().GetSafeNormal();
-		////AimMovementDiff = FVector::DotProduct(PlayerLookDir, MovementDir); 		
-		//if (GEngine)
-		//{
-		//	GEngine->AddOnScreenDebugMessage(1, 0.f, FColor::Red, 
-		//	FString::Printf(TEXT("Base Aim Rotation [%f]\nMovement Rotation [%f]\nAimMovementDiff [%f]\n\nPlayerLookDir (%f, %f)\nMovementDir (%f, %f)"), 
-		//	AimRotation.Yaw, 
-		//	MovementRotation.Yaw, 
-		//	AimMovementDiff,
-		//	PlayerLookDir.X,
-		//	PlayerLookDir.Y, 
-		//	MovementDir.X,
-		//	MovementDir.Y));
-		//}
+	// Update FootSpeed based off the lateral speed of the character from velocity (disregard vertical movement)
+	FVector LateralVelocity = Snapshot.Velocity;
+	LateralVelocity.Z = 0.f; // we only want the lateral component of velocity so that if the character is falling or moving in a vertical way it doesn't effect our speed
+	Anim.FootSpeed = LateralVelocity.Size(); // the length of the velocity vector is the speed
+
+	Anim.bIsInAir = Snapshot.bIsFalling;
+	Anim.bIsAccelerating = Snapshot.bIsAccelerating;
+
+	// Difference between where the controller is pointing and where we're moving
+	const FRotator MovementRotation = UKismetMathLibrary::MakeRotFromX(Snapshot.Velocity); // rotation from the world X direction based on some direction vector
+	Anim.AimMovementDiff = UKismetMathLibrary::NormalizedDeltaRotator(MovementRotation, Snapshot.AimRotation).Yaw;
+
+	// If we're moving, store the this frames movement so on the frame we stop moving, we know which direction we were headed to play the correct stop animation
+	if (Snapshot.Velocity.Size() > 0.f)
+	{
+		Anim.LastAimMovementDiff = Anim.AimMovementDiff;
 	}
 
-	CheckForTurnInPlace(DeltaTime);
-}
+	Anim.bIsAiming = Snapshot.bIsAiming;
+	Anim.bReloadingInProgress = Snapshot.bReloading;
 
-void UProjectMarcusAnimInstance::NativeInitializeAnimation()
-{
-	if (PMCharacter == nullptr)
+	// Order matters here.
+	if (Anim.bReloadingInProgress)
 	{
-		FindOwner();
+		Anim.AimOffsetState = EAimOffsetState::EAOS_Reloading;
+	}
+	else if (Anim.bIsInAir)
+	{
+		Anim.AimOffsetState = EAimOffsetState::EAOS_InAir;
+	}
+	else if (Anim.bIsAiming)
+	{
+		Anim.AimOffsetState = EAimOffsetState::EAOS_ADS;
 	}
+	else
+	{
+		Anim.AimOffsetState = EAimOffsetState::EAOS_Hip;
+	}
+
+	CheckForTurnInPlace();
 }
 
-void UProjectMarcusAnimInstance::CheckForTurnInPlace(float DeltaTime)
+void FProjectMarcusAnimInstanceProxy::CheckForTurnInPlace()
 {
+	UProjectMarcusAnimInstance& Anim = *MarcusInstance;
+
 	// store the pitch (getting a rotation corresponding to the controller which matches our crosshairs)
-	if (PMCharacter)
-	{
-		CurrentPitch = PMCharacter->GetBaseAimRotation().Pitch;
-	}
+	Anim.CurrentPitch = Snapshot.AimRotation.Pitch;
 
 	// for now don't allow turning in place while moving
-	if (FootSpeed > 0 || bIsInAir)
+	if (Anim.FootSpeed > 0 || Anim.bIsInAir)
 	{
-		YawDiffFromRootToCharacter = 0;
-		CharacterYaw = PMCharacter->GetActorRotation().Yaw;
-		CharacterYawLastFrame = CharacterYaw;
-		RotationCurveLastFrame = 0.f;
-		RotationCurve = 0.f;
+		Anim.YawDiffFromRootToCharacter = 0;
+		Anim.CharacterYaw = Snapshot.ActorYaw;
+		Anim.CharacterYawLastFrame = Anim.CharacterYaw;
+		Anim.RotationCurveLastFrame = 0.f;
+		Anim.RotationCurve = 0.f;
 		return;
 	}
 
-	if(PMCharacter)
+	Anim.CharacterYawLastFrame = Anim.CharacterYaw;
+	Anim.CharacterYaw = Snapshot.ActorYaw;
+	const float CharacterYawDelta = Anim.CharacterYaw - Anim.CharacterYawLastFrame;
+
+	// Clamped to [-180, 180]
+	Anim.YawDiffFromRootToCharacter = UKismetMathLibrary::NormalizeAxis(Anim.YawDiffFromRootToCharacter - CharacterYawDelta);
+
+	// Curves from the last evaluation, same values GetCurveValue returns
+	const TMap<FName, float>& Curves = GetAnimationCurves(EAnimCurveType::AttributeCurve);
+
+	// This will only be true if the animation playing has the Turning metadata
+	const float* Turning = Curves.Find(TurningCurveName);
+	if (Turning && *Turning > 0.f)
 	{
-		CharacterYawLastFrame = CharacterYaw;
-		CharacterYaw = PMCharacter->GetActorRotation().Yaw;
-		const float CharacterYawDelta = CharacterYaw - CharacterYawLastFrame;
-		
-		// Clamped to [-180, 180]
-		YawDiffFromRootToCharacter = UKismetMathLibrary::NormalizeAxis(YawDiffFromRootToCharacter - CharacterYawDelta);
-		
-		// This will only be true if the animation playing has the Turning metadata 
-		float turning = GetCurveValue(TEXT("Turning"));
-		if (turning > 0.f)
+		const float* RotationValue = Curves.Find(RotationCurveName);
+		const float NewRotationCurve = RotationValue ? *RotationValue : 0.f;
+
+		// When the animation starts its first frame RotationCurve won't have a value, so setting  RotationCurveLastFrame = RotationCurve then subtracting them would essentially be 0-90
+		// What we actually want is the delta between frames during the curve (which is a very small number like 89.5-90
+		if (Anim.RotationCurveLastFrame == 0.f)
+		{
+			Anim.RotationCurve = NewRotationCurve;
+			Anim.RotationCurveLastFrame = Anim.RotationCurve;
+		}
+		else
+		{
+			Anim.RotationCurveLastFrame = Anim.RotationCurve;
+			Anim.RotationCurve = NewRotationCurve;
+		}
+
+		const float RotationCurveDelta = FMath::Abs(Anim.RotationCurveLastFrame - Anim.RotationCurve);
+
+		// if YawDiffFromRootToCharacter is pos = turning left. is neg = turning right
+		if (Anim.YawDiffFromRootToCharacter < 0.f) // turning right, we need to add (which decreases the amount we are compensating for turning) meaning we will start to turn the root to the direction we need
+		{
+			Anim.YawDiffFromRootToCharacter += RotationCurveDelta;
+		}
+		else
 		{
-			// When the animation starts its first frame RotationCurve won't have a value, so setting  RotationCurveLastFrame = RotationCurve then subtracting them would essentially be 0-90
-			// What we actually want is the delta between frames during the curve (which is a very small number like 89.5-90
-			if (RotationCurveLastFrame == 0.f)
-			{
-				RotationCurve = GetCurveValue(TEXT("RotationV2"));
-				RotationCurveLastFrame = RotationCurve;
-			}
-			else
-			{
-				RotationCurveLastFrame = RotationCurve;
-				RotationCurve = GetCurveValue(TEXT("RotationV2"));
-			}
-
-			const float RotationCurveDelta = FMath::Abs(RotationCurveLastFrame - RotationCurve);
-
-			// if YawDiffFromRootToCharacter is pos = turning left. is neg = turning right
-			if (YawDiffFromRootToCharacter < 0.f) // turning right, we need to add (which decreases the amount we are compensating for turning) meaning we will start to turn the root to the direction we need
-			{
-				YawDiffFromRootToCharacter += RotationCurveDelta;
-			}
-			else
-			{
-				YawDiffFromRootToCharacter -= RotationCurveDelta; 
-			}
-
-			// Always clamp between our two maxima
-			YawDiffFromRootToCharacter = FMath::Clamp(YawDiffFromRootToCharacter, -90.f, 90.f);
+			Anim.YawDiffFromRootToCharacter -= RotationCurveDelta;
 		}
+
+		// Always clamp between our two maxima
+		Anim.YawDiffFromRootToCharacter = FMath::Clamp(Anim.YawDiffFromRootToCharacter, -90.f, 90.f);
+	}
+}
+
+void UProjectMarcusAnimInstance::UpdateAnimationProperties(float DeltaTime)
+{
+	// Kept so existing graphs still compile, FProjectMarcusAnimInstanceProxy::Update does this work now
+}
+
+void UProjectMarcusAnimInstance::NativeInitializeAnimation()
+{
+	if (PMCharacter == nullptr)
+	{
+		FindOwner();
 	}
 }
 
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
 #include "ProjectMarcusAnimInstance.generated.h"
 
 UENUM(BlueprintType)
@@ -14,6 +15,51 @@ enum class EAimOffsetState : uint8
 	EAOS_Max UMETA(DisplayName = "InvalidMax")
 };
 
+/**
+ * Runs the UProjectMarcusAnimInstance update on the anim worker thread.
+ * PreUpdate (game thread) only copies the bits of character state the update needs. Update (worker) does the strafe,
+ * aim offset and turn in place math from that copy and writes the results straight into the anim instance properties,
+ * which the anim graph reads right after on the same worker.
+ */
+USTRUCT()
+struct FProjectMarcusAnimInstanceProxy : public FAnimInstanceProxy
+{
+	GENERATED_BODY()
+
+	FProjectMarcusAnimInstanceProxy() {}
+	FProjectMarcusAnimInstanceProxy(UAnimInstance* InAnimInstance) : FAnimInstanceProxy(InAnimInstance) {}
+
+protected:
+	virtual void Initialize(UAnimInstance* InAnimInstance) override;
+	virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+	virtual void Update(float DeltaSeconds) override;
+
+private:
+	// Handles updating turning in place
+	void CheckForTurnInPlace();
+
+	// Character state copied on the game thread
+	struct FCharacterSnapshot
+	{
+		FVector Velocity = FVector::ZeroVector;
+		FRotator AimRotation = FRotator::ZeroRotator;
+		float ActorYaw = 0.f;
+		bool bIsFalling = false;
+		bool bIsAccelerating = false;
+		bool bIsAiming = false;
+		bool bReloading = false;
+		bool bValid = false;
+	};
+
+	FCharacterSnapshot Snapshot;
+
+	class UProjectMarcusAnimInstance* MarcusInstance = nullptr;
+
+	// Curves are looked up by name, build the names once instead of every update
+	static const FName TurningCurveName;
+	static const FName RotationCurveName;
+};
+
 /**
  * 
  */
@@ -23,16 +69,24 @@ class PROJECTMARCUS_API UProjectMarcusAnimInstance : public UAnimInstance
 	GENERATED_BODY()	
 
 public:
-	UFUNCTION(BlueprintCallable)
-	void UpdateAnimationProperties(float DeltaTime); // behaves much like tick function in actors instead of overriding NativeUpdateAnimationProperties
+	// Does nothing, the update runs on the anim worker in FProjectMarcusAnimInstanceProxy. Remove the call from the event graph
+	UFUNCTION(BlueprintCallable, meta = (DeprecatedFunction, DeprecationMessage = "Properties are updated by the anim instance proxy on the worker thread, remove this call."))
+	void UpdateAnimationProperties(float DeltaTime);
 
 	virtual void NativeInitializeAnimation() override; // kinda like beginPlay for actors but for AnimInstances
 
 protected:
-	// Handles updating turning in place
-	void CheckForTurnInPlace(float DeltaTime);
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override { return &Proxy; }
+
+	// Proxy is a member, nothing to free
+	virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override {}
 
 private:
+	friend struct FProjectMarcusAnimInstanceProxy;
+
+	UPROPERTY(Transient)
+	FProjectMarcusAnimInstanceProxy Proxy;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
 	class AProjectMarcusCharacter* PMCharacter;
 
@@ -9,8 +9,22 @@
 #include "Particles/ParticleSystemComponent.h"
 #include "ProjectMarcus/Interactables/WeaponItem.h"
 #include "ProjectMarcus/Interactables/AmmoItem.h"
+#include "ProjectMarcus/Interactables/ItemPoolSubsystem.h"
+#include "ProjectMarcus/Interactables/ItemSpatialSubsystem.h"
+#include "ProjectMarcus/Inventory/InventoryComponent.h"
 #include "ProjectMarcus/Interfaces/BulletHitInterface.h"
 #include "ProjectMarcus/Enemies/Enemy.h"
+#include "ProjectMarcus/PlayerController/ProjectMarcusPlayerController.h"
+#include "ProjectMarcus/UI/HUDViewModel.h"
+#include "ProjectMarcus/Combat/AsyncHitscanSubsystem.h"
+#include "ProjectMarcus/Combat/DamageQueueSubsystem.h"
+#include "ProjectMarcus/Subsystems/CombatAudioSubsystem.h"
+#include "ProjectMarcus/Subsystems/EmitterPoolSubsystem.h"
+#include "ProjectMarcus/Subsystems/SpawnQueueSubsystem.h"
+#include "ProjectMarcus/ProjectMarcus.h"
+
+DECLARE_CYCLE_STAT(TEXT("Send Bullets"), STAT_SendBullets, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Shots Fired"), STAT_ShotsFired, STATGROUP_ProjectMarcus);
 
 // Sets default values
 AProjectMarcusCharacter::AProjectMarcusCharacter()
@@ -61,6 +75,8 @@ AProjectMarcusCharacter::AProjectMarcusCharacter()
 		HandSceneComponent = CreateDefaultSubobject<USceneComponent>(TEXT("HandSceneComponent"));
 	}
 
+	Inventory = CreateDefaultSubobject<UInventoryComponent>(TEXT("Inventory"));
+
 	// Setup scene components for picking up items interpolation
 	if (WeaponInterpComp == nullptr)
 	{
@@ -93,9 +109,25 @@ void AProjectMarcusCharacter::Tick(float DeltaTime)
 	UpdateCameraZoom(DeltaTime);
 	UpdateCurrentLookRate();
 
+	UpdateAutoFire(DeltaTime);
 	CalculateCrosshairSpread(DeltaTime);
 
+	UpdateItemsInRange();
 	CheckForItemsInRange();
+
+	// Only the counts that changed this frame, however many times they changed
+	if (AmmoStash.HasChanges())
+	{
+		UHUDViewModel* HUDViewModel = GetHUDViewModel();
+		AmmoStash.ConsumeChanges([this, HUDViewModel](EAmmoType AmmoType, int32 AmmoCount)
+		{
+			AmmoChangedDelegate.Broadcast(AmmoType, AmmoCount);
+			if (HUDViewModel && EquippedWeapon && EquippedWeapon->GetAmmoType() == AmmoType)
+			{
+				HUDViewModel->SetStashAmmo(AmmoCount);
+			}
+		});
+	}
 }
 
 // Called to bind functionality to input
@@ -162,6 +194,10 @@ void AProjectMarcusCharacter::RemoveItemInRange(AItemBase* ItemOutOfRange)
 		if (CurrentlyFocusedItem && ItemOutOfRange->GetUniqueID() == CurrentlyFocusedItem->GetUniqueID())
 		{
 			CurrentlyFocusedItem = nullptr;
+			if (UHUDViewModel* HUDViewModel = GetHUDViewModel())
+			{
+				HUDViewModel->SetFocusedItem(nullptr);
+			}
 		}
 	}
 }
@@ -188,10 +224,8 @@ void AProjectMarcusCharacter::PickupItemAfterPreview(AItemBase* PickedupItem)
 {
 	if (AWeaponItem* WeaponItem = Cast<AWeaponItem>(PickedupItem))
 	{
-		if (Inventory.Num() < INVENTORY_CAPACITY)
+		if (Inventory->AddItem(WeaponItem) != INDEX_NONE)
 		{
-			WeaponItem->SetInventorySlotIndex(Inventory.Num());// the index of the new item will be the size of the inventory existing before it
-			Inventory.Add(WeaponItem);
 			WeaponItem->UpdateToState(EItemState::EIS_PickedUpNoEquip);
 		}
 		else
@@ -211,11 +245,7 @@ void AProjectMarcusCharacter::PickupItemAfterPreview(AItemBase* PickedupItem)
 
 int32 AProjectMarcusCharacter::GetAmmoStashForType(EAmmoType AmmoType)
 {
-	if (AmmoStashMap.Contains(AmmoType))
-	{
-		return AmmoStashMap[AmmoType];
-	}
-	return -1;
+	return AmmoStash.Get(AmmoType);
 }
 
 void AProjectMarcusCharacter::GetPickupLocationLocation(int32 LocationIndex, FVector& OutPickupLocation)
@@ -258,9 +288,8 @@ void AProjectMarcusCharacter::BeginPlay()
 		CurrentFOV = CameraData.DefaultFOV;
 	}
 
-	EquipWeapon(SpawnDefaultWeapon());
-	Inventory.Add(EquippedWeapon);
-	EquippedWeapon->SetInventorySlotIndex(0);
+	// The HUD is refreshed once the weapon is live, in OnDefaultWeaponSpawned
+	SpawnDefaultWeapon();
 
 	CurrentGamepadTurnRate = MoveData.GamepadTurnRate;
 	CurrentGamepadLookUpRate = MoveData.GamepadLookUpRate;
@@ -269,6 +298,8 @@ void AProjectMarcusCharacter::BeginPlay()
 	CurrentMouseLookUpRate = MoveData.MouseAimingLookUpRate;
 
 	FillAmmoStash();
+
+	FireScheduler.SetFireInterval(AutomaticFireRate);
 }
 
 void AProjectMarcusCharacter::MoveForward(float Value)
@@ -349,7 +380,8 @@ void AProjectMarcusCharacter::ReloadButtonPressed()
 
 void AProjectMarcusCharacter::SwapEquippedWithInventory(int32 IndexCurrentlyAt, int32 IndexToGoTo)
 {
-	if (IndexCurrentlyAt == IndexToGoTo || IndexToGoTo >= Inventory.Num())
+	AWeaponItem* NewWeapon = Cast<AWeaponItem>(Inventory->GetItem(IndexToGoTo));
+	if (IndexCurrentlyAt == IndexToGoTo || NewWeapon == nullptr)
 	{
 		return;
 	}
@@ -360,7 +392,6 @@ void AProjectMarcusCharacter::SwapEquippedWithInventory(int32 IndexCurrentlyAt,
 		WeaponToStore->UpdateToState(EItemState::EIS_PickedUpNoEquip);
 	}
 
-	AWeaponItem* NewWeapon = Cast<AWeaponItem>(Inventory[IndexToGoTo]);
 	EquipWeapon(NewWeapon);
 
 	CombatState = ECombatState::ECS_Equipping;
@@ -384,6 +415,11 @@ void AProjectMarcusCharacter::PreSwapInventoryItem(int32 PressedIndex)
 		return;
 	}
 
+	if (EquippedWeapon == nullptr)
+	{// The default weapon spawns deferred, nothing to swap from until it's in hand
+		return;
+	}
+
 	if (EquippedWeapon->GetInventorySlotIndex() != PressedIndex)
 	{
 		SwapEquippedWithInventory(EquippedWeapon->GetInventorySlotIndex(), PressedIndex);
@@ -434,12 +470,14 @@ void AProjectMarcusCharacter::FireWeapon()
 
 	if (WeaponClipHasAmmo())
 	{
-		PlayBulletFireSfx();
-		SendBulletWithVfx();
-		ApplyWeaponKickback();
-		StartCrosshairBulletFire();
-		EquippedWeapon->ConsumeAmmo();
-		StartFireTimer();
+		// First shot goes out on the press, the scheduler takes over from here while the trigger is held
+		CombatState = ECombatState::ECS_FireTimerInProgress;
+		FireScheduler.FireNow();
+
+		FWeaponFireScheduler::FShotAges ShotAges;
+		ShotAges.Add(0.f);
+		FireShots(ShotAges, 0.f);
+		GetFireView(LastFireView);
 	}
 	else
 	{// If they tried firing but have nothing in the clip, reload for them
@@ -455,32 +493,37 @@ void AProjectMarcusCharacter::CalculateCrosshairSpread(float DeltaTime)
 	Velocity.Z = 0.f; // Must zero out the vertical velocity since this should only be effected by walking 
 	float SpeedInWalkRange = Velocity.Size();
 	// Low number when moving slowly, high number when moving quickly
-	CrosshairVelocityFactor = (SpeedInWalkRange - WallkSpeedRange.X) / (WallkSpeedRange.Y - WallkSpeedRange.X);
-	
-	// Calculate Crosshair Aim factor
+	const float NewVelocityFactor = (SpeedInWalkRange - WallkSpeedRange.X) / (WallkSpeedRange.Y - WallkSpeedRange.X);
+
 	UCharacterMovementComponent* MoveComp = GetCharacterMovement();
-	if (MoveComp && MoveComp->IsFalling())// TODO: IsFalling is not technically what I think I want to use
-	{// Move further away slowly
-		CrosshairInAirFactor = FMath::FInterpTo(CrosshairInAirFactor, 2.25f, DeltaTime, 2.25f);
-	}
-	else
-	{// Move inwards very quickly
-		CrosshairInAirFactor = FMath::FInterpTo(CrosshairInAirFactor, 0.f, DeltaTime, 30.f);
-	}
+	const bool bInAir = MoveComp && MoveComp->IsFalling(); // TODO: IsFalling is not technically what I think I want to use
+	const float InAirTarget = bInAir ? 2.25f : 0.f;
+	const float AimTarget = bIsAiming ? -0.6f : 0.f;
+	const float ShootingTarget = bIsFiringBullet ? 0.3f : 0.f;
 
-	if (bIsAiming)
-	{// Move inwards very quickly
-		CrosshairAimFactor = FMath::FInterpTo(CrosshairAimFactor, -0.6f, DeltaTime, 30.f);
-	}
-	else
-	{// Move outwards very quickly
-		CrosshairAimFactor = FMath::FInterpTo(CrosshairAimFactor, 0.f, DeltaTime, 30.f);
+	// FInterpTo lands exactly on its target, so once every factor is there the spread can't change until something moves
+	if (NewVelocityFactor == CrosshairVelocityFactor && CrosshairInAirFactor == InAirTarget && CrosshairAimFactor == AimTarget && CrosshairShootingFactor == ShootingTarget)
+	{
+		return;
 	}
 
-	CrosshairShootingFactor = FMath::FInterpTo(CrosshairShootingFactor, bIsFiringBullet ? 0.3f : 0.f, DeltaTime, 60.f);
+	CrosshairVelocityFactor = NewVelocityFactor;
+
+	// Move further away slowly when jumping, back inwards very quickly when landing
+	CrosshairInAirFactor = FMath::FInterpTo(CrosshairInAirFactor, InAirTarget, DeltaTime, bInAir ? 2.25f : 30.f);
+
+	// Move inwards/outwards very quickly
+	CrosshairAimFactor = FMath::FInterpTo(CrosshairAimFactor, AimTarget, DeltaTime, 30.f);
+
+	CrosshairShootingFactor = FMath::FInterpTo(CrosshairShootingFactor, ShootingTarget, DeltaTime, 60.f);
 
 	//GEngine->AddOnScreenDebugMessage(1, 0.f, FColor::Green, FString::Printf(TEXT("\n\nCrosshairSpreadMultiplier = %f\nCrosshairVelocityFactor = %f\nCrosshairInAirFactor = %f"), CrosshairSpreadMultiplier, CrosshairVelocityFactor, CrosshairInAirFactor));
 	CrosshairSpreadMultiplier = 0.5f + CrosshairVelocityFactor + CrosshairInAirFactor + CrosshairAimFactor + CrosshairShootingFactor;
+
+	if (UHUDViewModel* HUDViewModel = GetHUDViewModel())
+	{
+		HUDViewModel->SetCrosshairSpread(CrosshairSpreadMultiplier);
+	}
 }
 
 void AProjectMarcusCharacter::StartCrosshairBulletFire()
@@ -507,36 +550,84 @@ void AProjectMarcusCharacter::FireButtonPressed()
 void AProjectMarcusCharacter::FireButtonReleased()
 {
 	bFireButtonPressed = false;
+	StopFireLoopSfx();
 }
 
-void AProjectMarcusCharacter::AutoFireReset()
+void AProjectMarcusCharacter::UpdateAutoFire(float DeltaTime)
 {
-	CombatState = ECombatState::ECS_Unoccupied;
+	if (CombatState != ECombatState::ECS_FireTimerInProgress)
+	{
+		return;
+	}
 
-	if (WeaponClipHasAmmo())
+	// Letting go of the trigger (or running dry) just stops new shots being owed, the interval still has to run out
+	const int32 MaxShots = bFireButtonPressed && EquippedWeapon ? EquippedWeapon->GetAmmoInClip() : 0;
+
+	FWeaponFireScheduler::FShotAges ShotAges;
+	FireScheduler.Advance(DeltaTime, MaxShots, ShotAges);
+	FireShots(ShotAges, DeltaTime);
+
+	GetFireView(LastFireView);
+
+	// Still owed a shot while held with ammo, so this only happens once the cycle is really over
+	if (FireScheduler.IsReady())
 	{
-		if (bFireButtonPressed)
-		{
-			FireWeapon();
-		}
+		FinishFireCycle();
 	}
-	else
+}
+
+void AProjectMarcusCharacter::FinishFireCycle()
+{
+	CombatState = ECombatState::ECS_Unoccupied;
+	LastFireView.bValid = false;
+	StopFireLoopSfx();
+
+	if (!WeaponClipHasAmmo())
 	{
 		ReloadWeapon();
 	}
 }
 
-AWeaponItem* AProjectMarcusCharacter::SpawnDefaultWeapon()
+void AProjectMarcusCharacter::SpawnDefaultWeapon()
 {
 	if (DefaultWeaponClass)
 	{
 		if (GetWorld())
 		{
-			// Spawn the weapon
-			return Cast<AWeaponItem>(GetWorld()->SpawnActor<AWeaponItem>(DefaultWeaponClass));
+			// Spawn the weapon (or reuse a pooled one)
+			const FTransform SpawnTransform(GetActorRotation(), GetActorLocation());
+			if (USpawnQueueSubsystem* SpawnQueue = GetWorld()->GetSubsystem<USpawnQueueSubsystem>())
+			{
+				// Spawned inside our capsule and attached straight away, so it must not be pushed out or fail
+				SpawnQueue->QueueSpawn(DefaultWeaponClass, SpawnTransform, ESpawnPriority::ESP_Critical, FOnQueuedSpawnFinished::CreateUObject(this, &AProjectMarcusCharacter::OnDefaultWeaponSpawned),
+					ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+			}
+			else if (UItemPoolSubsystem* ItemPool = GetWorld()->GetSubsystem<UItemPoolSubsystem>())
+			{
+				OnDefaultWeaponSpawned(ItemPool->AcquireItem<AWeaponItem>(DefaultWeaponClass, SpawnTransform));
+			}
 		}
 	}
-	return nullptr;
+}
+
+void AProjectMarcusCharacter::OnDefaultWeaponSpawned(AActor* SpawnedActor)
+{
+	AWeaponItem* DefaultWeapon = Cast<AWeaponItem>(SpawnedActor);
+	if (DefaultWeapon == nullptr)
+	{
+		return;
+	}
+
+	// Something may have been picked up while it was queued
+	if (EquippedWeapon || Inventory->IsFull())
+	{
+		DefaultWeapon->UpdateToState(EItemState::EIS_Drop);
+		return;
+	}
+
+	EquipWeapon(DefaultWeapon);
+	Inventory->AddItem(EquippedWeapon);
+	RefreshHUDViewModel();
 }
 
 void AProjectMarcusCharacter::EquipWeapon(AWeaponItem* NewWeapon)
@@ -556,10 +647,17 @@ void AProjectMarcusCharacter::EquipWeapon(AWeaponItem* NewWeapon)
 		}
 
 		// Inform UI of the change from old (equipped) to current (new)
-		EquipItemDelegate.Broadcast(EquippedWeapon == nullptr ? -1 : EquippedWeapon->GetInventorySlotIndex(), NewWeapon->GetInventorySlotIndex());
+		Inventory->NotifyEquipped(EquippedWeapon == nullptr ? -1 : EquippedWeapon->GetInventorySlotIndex(), NewWeapon);
+
+		// The fire loop belongs to the old weapon
+		StopFireLoopSfx();
 
+		// Owned by us while equipped so its clip goes to our HUD
 		EquippedWeapon = NewWeapon;
+		EquippedWeapon->SetOwner(this);
 		EquippedWeapon->UpdateToState(EItemState::EIS_Equipped);
+
+		RefreshHUDViewModel();
 	}
 }
 
@@ -568,6 +666,7 @@ void AProjectMarcusCharacter::DropWeapon()
 	if (EquippedWeapon)
 	{
 		EquippedWeapon->UpdateToState(EItemState::EIS_Drop);
+		EquippedWeapon->SetOwner(nullptr);
 		EquippedWeapon->ThrowWeapon();
 	}
 }
@@ -576,10 +675,9 @@ void AProjectMarcusCharacter::SwapWeapon(AWeaponItem* WeaponToSwap)
 {
 	if (EquippedWeapon)
 	{
-		if (Inventory.Num() - 1 >= EquippedWeapon->GetInventorySlotIndex())
+		if (Inventory->GetItem(EquippedWeapon->GetInventorySlotIndex()) != nullptr)
 		{
-			Inventory[EquippedWeapon->GetInventorySlotIndex()] = WeaponToSwap;
-			WeaponToSwap->SetInventorySlotIndex(EquippedWeapon->GetInventorySlotIndex());
+			Inventory->SetItem(EquippedWeapon->GetInventorySlotIndex(), WeaponToSwap);
 		}
 	}
 	DropWeapon();
@@ -603,34 +701,35 @@ void AProjectMarcusCharacter::PickupAmmo(class AAmmoItem* Ammo)
 		}
 	}
 
-	//TODO: Dont do this...
-	Ammo->Destroy();
+	// Park it for the next ammo drop instead of destroying it
+	UItemPoolSubsystem* ItemPool = GetWorld() ? GetWorld()->GetSubsystem<UItemPoolSubsystem>() : nullptr;
+	if (ItemPool)
+	{
+		ItemPool->ReleaseItem(Ammo);
+	}
+	else if (Ammo)
+	{
+		Ammo->Destroy();
+	}
 }
 
 void AProjectMarcusCharacter::RemoveAmmoFromStash(EAmmoType AmmoType, int32 RemovedAmmo)
 {
-	ensure(AmmoStashMap.Contains(AmmoType));
-	if (AmmoStashMap.Find(AmmoType))
-	{
-		int32 CurAmmoForType = AmmoStashMap[AmmoType];
-		AmmoStashMap[AmmoType] = FMath::Max(CurAmmoForType - RemovedAmmo, 0);
-	}
+	AmmoStash.Remove(AmmoType, RemovedAmmo);
 }
 
 void AProjectMarcusCharacter::AddAmmoToStash(EAmmoType AmmoType, int32 AddedAmmo)
 {
-	ensure(AmmoStashMap.Contains(AmmoType));
-	if (AmmoStashMap.Find(AmmoType))
-	{
-		int32 CurAmmoForType = AmmoStashMap[AmmoType];
-		AmmoStashMap[AmmoType] = FMath::Min(CurAmmoForType + AddedAmmo, 999);
-	}
+	AmmoStash.Add(AmmoType, AddedAmmo);
 }
 
 void AProjectMarcusCharacter::FillAmmoStash()
 {
-	AmmoStashMap.Empty();
-	AmmoStashMap = { {EAmmoType::EAT_9mm, Starting9mmAmmo}, {EAmmoType::EAT_AR, StartingARAmmo} };
+	AmmoStash.Set(EAmmoType::EAT_9mm, Starting9mmAmmo);
+	AmmoStash.Set(EAmmoType::EAT_AR, StartingARAmmo);
+
+	// Widgets bound after this still get the starting counts
+	AmmoStash.MarkAllChanged();
 }
 
 void AProjectMarcusCharacter::ReloadWeapon()
@@ -671,28 +770,19 @@ void AProjectMarcusCharacter::FinishReloading()
 {
 	if (EquippedWeapon)
 	{
-		EAmmoType CurAmmoType = EquippedWeapon->GetAmmoType();
-		if (AmmoStashMap.Contains(CurAmmoType))
-		{
-			int32 AmmoPutIntoClip = 0;
-			int32 EmptySpaceInClip = EquippedWeapon->GetMaxAmmoCapacity() - EquippedWeapon->GetAmmoInClip();
-
-			if (EmptySpaceInClip > AmmoStashMap[CurAmmoType])
-			{// Can only fill clip with the few bullets we had in the stash
-				AmmoPutIntoClip = AmmoStashMap[CurAmmoType];
-			}
-			else
-			{// Fill entire clip
-				AmmoPutIntoClip = EmptySpaceInClip;
-			}
-
-			EquippedWeapon->ReloadClip(AmmoPutIntoClip);
-			RemoveAmmoFromStash(CurAmmoType, AmmoPutIntoClip);
-		}
+		// Fills the clip, or puts in the few bullets left in the stash
+		const int32 EmptySpaceInClip = EquippedWeapon->GetMaxAmmoCapacity() - EquippedWeapon->GetAmmoInClip();
+		const int32 AmmoPutIntoClip = AmmoStash.Remove(EquippedWeapon->GetAmmoType(), EmptySpaceInClip);
+		EquippedWeapon->ReloadClip(AmmoPutIntoClip);
 	}
 
+	CombatState = ECombatState::ECS_Unoccupied;
+
 	// In case the user is still holding the fire button during reload
-	AutoFireReset();
+	if (bFireButtonPressed)
+	{
+		FireWeapon();
+	}
 }
 
 void AProjectMarcusCharacter::GrabClip()
@@ -734,35 +824,19 @@ void AProjectMarcusCharacter::FinishEquipping()
 
 int32 AProjectMarcusCharacter::GetEmptyInventorySlot()
 {
-	// Needed in case something is dropped from the inventory
-	for (uint32 i = 0, End = Inventory.Num(); i < End; ++i)
-	{
-		if (Inventory[i] == nullptr)
-		{
-			return i;
-		}
-	}
-
-	if (Inventory.Num() == INVENTORY_CAPACITY)
-	{
-		return Inventory.Num() - 1;
-	}
-
-	// The next free slot in the inventory
-	return Inventory.Num();
+	// A full inventory highlights its last slot
+	const int32 FreeSlot = Inventory->GetFirstFreeSlot();
+	return FreeSlot != INDEX_NONE ? FreeSlot : UInventoryComponent::NumSlots - 1;
 }
 
 void AProjectMarcusCharacter::HighlightInventorySlot()
 {
-	const int32 NextEmptySlot = GetEmptyInventorySlot();
-	HighlightIconDelegate.Broadcast(NextEmptySlot, true);
-	HighlightedSlot = NextEmptySlot;
+	Inventory->HighlightSlot(GetEmptyInventorySlot());
 }
 
 void AProjectMarcusCharacter::UnHighlightInventorySlot()
 {
-	HighlightIconDelegate.Broadcast(HighlightedSlot, false);
-	HighlightedSlot = -1;
+	Inventory->HighlightSlot(INDEX_NONE);
 }
 
 void AProjectMarcusCharacter::UpdateCameraZoom(float DeltaTime)
@@ -808,6 +882,49 @@ void AProjectMarcusCharacter::UpdateCurrentLookRate()
 	}
 }
 
+void AProjectMarcusCharacter::UpdateItemsInRange()
+{
+	UItemSpatialSubsystem* ItemIndex = GetWorld() ? GetWorld()->GetSubsystem<UItemSpatialSubsystem>() : nullptr;
+	if (ItemIndex == nullptr)
+	{
+		return;
+	}
+
+	ItemRangeQueryResults.Reset();
+	ItemIndex->QueryItemsInRadius(GetActorLocation(), ItemPickupRange, ItemRangeQueryResults);
+
+	ItemRangeQueryIds.Reset();
+	for (AItemBase* Item : ItemRangeQueryResults)
+	{
+		ItemRangeQueryIds.Add(Item->GetUniqueID());
+		if (!ItemsInRange.Contains(Item->GetUniqueID()))
+		{
+			AddItemInRange(Item);
+			Item->SetCharacterInPickupRange(this);
+		}
+	}
+
+	// Anything we were in range of that the query no longer returns has left our range
+	TArray<AItemBase*, TInlineAllocator<8>> ItemsOutOfRange;
+	for (auto It = ItemsInRange.CreateIterator(); It; ++It)
+	{
+		if (!It->Value.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+		else if (!ItemRangeQueryIds.Contains(It->Key))
+		{
+			ItemsOutOfRange.Add(It->Value.Get());
+		}
+	}
+
+	for (AItemBase* Item : ItemsOutOfRange)
+	{
+		RemoveItemInRange(Item);
+		Item->SetCharacterInPickupRange(nullptr);
+	}
+}
+
 void AProjectMarcusCharacter::CheckForItemsInRange()
 {
 	if (ItemsInRange.Num())
@@ -817,64 +934,77 @@ void AProjectMarcusCharacter::CheckForItemsInRange()
 		FVector CrosshairLocationInWorld;
 		FVector CrosshairDirectionInWorld;
 		GetCrosshairWorldPosition(CrosshairLocationInWorld, CrosshairDirectionInWorld);
-		FVector LookDir = CrosshairLocationInWorld + CrosshairDirectionInWorld * TRACE_FAR;
 
+		// Copy positions out so the scoring kernel runs over plain arrays
+		FItemFocusParams FocusParams;
+		FocusCandidates.Reset();
+		FocusCandidateItems.Reset();
 		for (auto It = ItemsInRange.CreateConstIterator(); It; ++It)
 		{
-			AItemBase* Item = Cast<AItemBase>(It->Value);
-			if (Item)
+			if (AItemBase* Item = It->Value.Get())
 			{
-				// Must use crosshair location again vs GetActorLocation() because we want to know the difference in LOOK vectors, not position vectors
-				FVector DirToThisItem = Item->GetActorLocation() - CrosshairLocationInWorld;
-				float LookingAtItemAmount = FVector::DotProduct(LookDir.GetSafeNormal(), DirToThisItem.GetSafeNormal());
-				// If the look vector and direction to item is close, toggle the popup visible, otherwise toggle it off
-				if (LookingAtItemAmount >= ItemPopupVisibilityThreshold)
+				if (Item == CurrentlyFocusedItem)
 				{
-					Item->SetPickupItemVisuals(true);
-					// TODO: this might need to change once we can drop items from the inventory
-					Item->SetSwapInsteadOfPickup(Inventory.Num() == INVENTORY_CAPACITY);
-					
-					// Highlight slot
-					if (HighlightedSlot < 0)
-					{
-						if (AWeaponItem* WeaponItem = Cast<AWeaponItem>(Item))
-						{
-							HighlightInventorySlot();
-						}
-					}
-					// Regardless if one was set already, update the currently focused item to the latest one looking at
-					CurrentlyFocusedItem = Item;
+					FocusParams.CurrentFocusIndex = FocusCandidateItems.Num();
 				}
-				else
-				{
-					// If the item we are no longer looking at was our currently focused item, remove it
-					if (CurrentlyFocusedItem && Item->GetUniqueID() == CurrentlyFocusedItem->GetUniqueID())
-					{
-						CurrentlyFocusedItem = nullptr;
-					}
-					Item->SetPickupItemVisuals(false);
+				FocusCandidateItems.Add(Item);
+				FocusCandidates.Add(Item->GetActorLocation());
+			}
+		}
+		FocusCandidates.Finalize();
 
-					// Unhighlight any slot
-					if (HighlightedSlot >= 0)
-					{
-						if (AWeaponItem* WeaponItem = Cast<AWeaponItem>(Item))
-						{
-							UnHighlightInventorySlot();
-						}
-					}
-				}
+		// Must use crosshair location vs GetActorLocation() because we want to know the difference in LOOK vectors, not position vectors
+		FocusParams.ViewOrigin = CrosshairLocationInWorld;
+		FocusParams.ViewDir = CrosshairDirectionInWorld.GetSafeNormal();
+		FocusParams.LookThreshold = ItemPopupVisibilityThreshold;
+		FocusParams.DistanceWeight = ItemFocusDistanceWeight;
+		FocusParams.MaxDistance = ItemPickupRange;
+		FocusParams.HysteresisBand = ItemFocusHysteresis;
 
-				// If this is ammo try to auto pick it up
-				if (AAmmoItem* AmmoItem = Cast<AAmmoItem>(Item))
-				{
-					FVector DirFromPlayerToItem = AmmoItem->GetActorLocation() - GetActorLocation();
-					float DistanceToItem = DirFromPlayerToItem.Size();
+		const int32 BestIndex = ItemFocusScoring::FindBestCandidate(FocusCandidates, FocusParams);
+		AItemBase* NewFocusedItem = BestIndex != INDEX_NONE ? FocusCandidateItems[BestIndex] : nullptr;
+
+		// Only the single best item shows its popup, everything else in range is toggled off
+		for (AItemBase* Item : FocusCandidateItems)
+		{
+			Item->SetPickupItemVisuals(Item == NewFocusedItem);
+		}
 
-					DrawDebugLine(GetWorld(), GetActorLocation(), AmmoItem->GetActorLocation(), FColor::Green);
-					GEngine->AddOnScreenDebugMessage(1, -1, FColor::Green, FString::Printf(TEXT("DistanceToItem: %f"), DistanceToItem));
+		if (NewFocusedItem)
+		{
+			// TODO: this might need to change once we can drop items from the inventory
+			NewFocusedItem->SetSwapInsteadOfPickup(Inventory->IsFull());
+		}
 
-					AmmoItem->TryAutoPickup(DistanceToItem);
-				}
+		// Highlight the slot a focused weapon would go into, unhighlight once we stop focusing a weapon
+		if (Cast<AWeaponItem>(NewFocusedItem))
+		{
+			if (Inventory->GetHighlightedSlot() == INDEX_NONE)
+			{
+				HighlightInventorySlot();
+			}
+		}
+		else if (Inventory->GetHighlightedSlot() != INDEX_NONE)
+		{
+			UnHighlightInventorySlot();
+		}
+
+		CurrentlyFocusedItem = NewFocusedItem;
+		if (UHUDViewModel* HUDViewModel = GetHUDViewModel())
+		{
+			HUDViewModel->SetFocusedItem(NewFocusedItem);
+		}
+
+		// Iterate the copy, auto pickup removes items from ItemsInRange
+		for (AItemBase* Item : FocusCandidateItems)
+		{
+			// If this is ammo try to auto pick it up
+			if (AAmmoItem* AmmoItem = Cast<AAmmoItem>(Item))
+			{
+				FVector DirFromPlayerToItem = AmmoItem->GetActorLocation() - GetActorLocation();
+				float DistanceToItem = DirFromPlayerToItem.Size();
+
+				AmmoItem->TryAutoPickup(DistanceToItem);
 			}
 		}
 	}
@@ -882,74 +1012,192 @@ void AProjectMarcusCharacter::CheckForItemsInRange()
 
 void AProjectMarcusCharacter::PlayBulletFireSfx()
 {
+	UCombatAudioSubsystem* CombatAudio = GetWorld() ? GetWorld()->GetSubsystem<UCombatAudioSubsystem>() : nullptr;
+	if (CombatAudio == nullptr)
+	{
+		return;
+	}
+
+	// Automatic weapons hold one looping voice for as long as the trigger is down
+	USoundCue* FireLoopSound = EquippedWeapon ? EquippedWeapon->GetFireLoopSound() : nullptr;
+	if (FireLoopSound)
+	{
+		if (FireLoopVoice == nullptr)
+		{
+			FireLoopVoice = CombatAudio->StartLoop2D(FireLoopSound, ECombatSoundCategory::ECSC_Weapon, 2.f);
+		}
+		return;
+	}
+
 	if (FireSound)
 	{
-		UGameplayStatics::PlaySound2D(this, FireSound);
+		CombatAudio->PlaySound2D(FireSound, ECombatSoundCategory::ECSC_Weapon, 2.f);
 	}
 }
 
-void AProjectMarcusCharacter::SendBulletWithVfx()
+void AProjectMarcusCharacter::StopFireLoopSfx()
 {
-	// Muzzle Flash VFX + Linetracing/Collision + Impact Particles + Kickback Anim
-	const USkeletalMeshComponent* WeaponMesh = EquippedWeapon->GetItemMesh();
-	if (WeaponMesh)
+	if (FireLoopVoice == nullptr)
 	{
-		// Find the socket at the tip of the barrel with its current position and rotation and spawn a particle system
-		const USkeletalMeshSocket* BarrelSocket = WeaponMesh->GetSocketByName("BarrelSocket");
-		if (BarrelSocket)
+		return;
+	}
+
+	if (UCombatAudioSubsystem* CombatAudio = GetWorld() ? GetWorld()->GetSubsystem<UCombatAudioSubsystem>() : nullptr)
+	{
+		// Short fade so the loop doesn't click when cut mid cycle
+		CombatAudio->StopLoop(FireLoopVoice, 0.05f);
+	}
+	FireLoopVoice = nullptr;
+}
+
+void AProjectMarcusCharacter::FireShots(const FWeaponFireScheduler::FShotAges& ShotAges, float DeltaTime)
+{
+	if (ShotAges.Num() == 0 || EquippedWeapon == nullptr)
+	{
+		return;
+	}
+
+	INC_DWORD_STAT_BY(STAT_ShotsFired, ShotAges.Num());
+
+	// Stacking these per shot only restarts the montage and eats voices, once per frame is all that's noticeable
+	PlayBulletFireSfx();
+	ApplyWeaponKickback();
+	StartCrosshairBulletFire();
+
+	SendBullets(ShotAges, DeltaTime);
+	EquippedWeapon->ConsumeAmmo(ShotAges.Num());
+}
+
+void AProjectMarcusCharacter::SendBullets(const FWeaponFireScheduler::FShotAges& ShotAges, float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SendBullets);
+
+	FFireView CurrentView;
+	if (!GetFireView(CurrentView))
+	{
+		return;
+	}
+
+	// Only interpolate from the view captured last frame, anything older doesn't describe where this frame started
+	const bool bCanInterp = DeltaTime > 0.f && LastFireView.bValid && LastFireView.FrameNumber + 1 == GFrameCounter;
+
+	// Muzzle flash VFX, one for the newest shot
+	UEmitterPoolSubsystem* EmitterPool = GetWorld()->GetSubsystem<UEmitterPoolSubsystem>();
+	if (MuzzleFlash && EmitterPool)
+	{
+		EmitterPool->SpawnEmitter(MuzzleFlash, CurrentView.SocketTransform);
+	}
+
+	const float Damage = EquippedWeapon->GetDamage();
+	const float HeadshotDamage = EquippedWeapon->GetHeadshotDamage();
+	UAsyncHitscanSubsystem* AsyncHitscan = bUseAsyncHitscan ? GetWorld()->GetSubsystem<UAsyncHitscanSubsystem>() : nullptr;
+
+	struct FBatchedHit
+	{
+		FHitResult HitResult;
+		FTransform SocketTransform;
+	};
+	TArray<FBatchedHit, TInlineAllocator<8>> BatchedHits;
+
+	for (const float ShotAge : ShotAges)
+	{
+		FFireView ShotView = CurrentView;
+		if (bCanInterp)
 		{
-			const FTransform SocketTransform = BarrelSocket->GetSocketTransform(WeaponMesh);
+			// Age is how long before the end of the frame the shot went off, so a shot of age DeltaTime is where last frame ended
+			const float Alpha = FMath::Clamp(1.f - ShotAge / DeltaTime, 0.f, 1.f);
+			ShotView.SocketTransform.Blend(LastFireView.SocketTransform, CurrentView.SocketTransform, Alpha);
+			ShotView.CrosshairOrigin = FMath::Lerp(LastFireView.CrosshairOrigin, CurrentView.CrosshairOrigin, Alpha);
+			ShotView.CrosshairDirection = FMath::Lerp(LastFireView.CrosshairDirection, CurrentView.CrosshairDirection, Alpha).GetSafeNormal();
+		}
 
-			// Muzzle flash VFX
-			if (MuzzleFlash)
-			{
-				UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), MuzzleFlash, SocketTransform);
-			}
+		if (AsyncHitscan)
+		{
+			// Traces resolve on the physics worker, the hit gets applied when they come back
+			AsyncHitscan->QueueShot(this, ShotView.SocketTransform, ShotView.CrosshairOrigin, ShotView.CrosshairDirection, Damage, HeadshotDamage);
+			continue;
+		}
 
-			FHitResult BulletHitResult;
-			if (GetBulletHitLocation(SocketTransform.GetLocation(), BulletHitResult))
-			{
-				// Does hit actor implement bullet hit interface
-				if (BulletHitResult.Actor.IsValid())
-				{
-					IBulletHitInterface* BulletHitInterface = Cast<IBulletHitInterface>(BulletHitResult.Actor.Get());
-					if (BulletHitInterface)
-						BulletHitInterface->OnBulletHit_Implementation(BulletHitResult);
+		FBatchedHit& Hit = BatchedHits.AddDefaulted_GetRef();
+		Hit.SocketTransform = ShotView.SocketTransform;
+		if (!GetBulletHitLocation(ShotView.SocketTransform.GetLocation(), ShotView.CrosshairOrigin, ShotView.CrosshairDirection, Hit.HitResult))
+		{
+			BatchedHits.Pop(false);
+		}
+	}
 
-					AEnemy* HitEnemy = Cast<AEnemy>(BulletHitResult.Actor.Get());
-					if (HitEnemy)
-					{
-						float AppliedDamage = EquippedWeapon->GetDamage();
-						const bool bIsHeadshot = HitEnemy->GetHeadBone() == BulletHitResult.BoneName.ToString();
-						if (bIsHeadshot) // TODO: Don't like string compares here
-							AppliedDamage = EquippedWeapon->GetHeadshotDamage();
-						
-						UGameplayStatics::ApplyDamage(BulletHitResult.Actor.Get(), AppliedDamage, GetController(), this, UDamageType::StaticClass());
-					
-						HitEnemy->ShowHitNumber(AppliedDamage, BulletHitResult.Location, bIsHeadshot);
-					}
+	// Everything is traced before any hit is applied, damage/VFX from one shot can't change what the next one sees this frame
+	for (const FBatchedHit& Hit : BatchedHits)
+	{
+		ApplyBulletHit(Hit.HitResult, Hit.SocketTransform, Damage, HeadshotDamage);
+	}
+}
 
-					UE_LOG(LogTemp, Warning, TEXT("Hit component %s"), *BulletHitResult.BoneName.ToString());
-				}
-				else
-				{
-					// Spawn impact particles
-					if (BulletImpactParticles)
-					{
-						UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), BulletImpactParticles, BulletHitResult.Location);
-					}
-				}
+bool AProjectMarcusCharacter::GetFireView(FFireView& OutView)
+{
+	OutView.bValid = false;
+	OutView.FrameNumber = GFrameCounter;
 
-				// Spawn trail particles
-				if (BulletTrailParticles)
-				{
-					UParticleSystemComponent* Trail = UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), BulletTrailParticles, SocketTransform);
-					if (Trail)
-					{
-						Trail->SetVectorParameter("Target", BulletHitResult.Location); // makes it so the particles appear in a line from TraceStart  to TrailEndPoint
-					}
-				}
+	const USkeletalMeshComponent* WeaponMesh = EquippedWeapon ? EquippedWeapon->GetItemMesh() : nullptr;
+	const USkeletalMeshSocket* BarrelSocket = WeaponMesh ? WeaponMesh->GetSocketByName("BarrelSocket") : nullptr;
+	if (BarrelSocket == nullptr)
+	{
+		return false;
+	}
+
+	OutView.SocketTransform = BarrelSocket->GetSocketTransform(WeaponMesh);
+	OutView.bValid = GetCrosshairWorldPosition(OutView.CrosshairOrigin, OutView.CrosshairDirection);
+	return OutView.bValid;
+}
+
+void AProjectMarcusCharacter::ApplyBulletHit(const FHitResult& BulletHitResult, const FTransform& SocketTransform, float Damage, float HeadshotDamage)
+{
+	UEmitterPoolSubsystem* EmitterPool = GetWorld()->GetSubsystem<UEmitterPoolSubsystem>();
+
+	// Does hit actor implement bullet hit interface
+	if (BulletHitResult.Actor.IsValid())
+	{
+		IBulletHitInterface* BulletHitInterface = Cast<IBulletHitInterface>(BulletHitResult.Actor.Get());
+		if (BulletHitInterface)
+			BulletHitInterface->OnBulletHit_Implementation(BulletHitResult);
+
+		AActor* HitActor = BulletHitResult.Actor.Get();
+		UDamageQueueSubsystem* DamageQueue = GetWorld()->GetSubsystem<UDamageQueueSubsystem>();
+		const IDamageableInterface* Damageable = Cast<IDamageableInterface>(HitActor);
+		const int32 DamageItem = Damageable ? Damageable->GetDamageItem(BulletHitResult.Component.Get(), BulletHitResult.Item) : INDEX_NONE;
+		if (DamageQueue && DamageQueue->IsRegistered(HitActor, DamageItem))
+		{
+			float AppliedDamage = Damage;
+			bool bIsHeadshot = false;
+			if (const AEnemy* HitEnemy = Cast<AEnemy>(HitActor))
+			{
+				const EHitZone HitZone = HitEnemy->GetHitZone(BulletHitResult);
+				bIsHeadshot = HitZone == EHitZone::EHZ_Head;
+				AppliedDamage = (bIsHeadshot ? HeadshotDamage : Damage) * HitEnemy->GetHitZoneDamageMultiplier(HitZone);
 			}
+
+			// Hit number, health bar and death come out of the damage pass, once per target per frame
+			DamageQueue->QueueDamage(HitActor, AppliedDamage, BulletHitResult.Location, bIsHeadshot, GetController(), this, DamageItem);
+		}
+
+		UE_LOG(LogTemp, Verbose, TEXT("Hit component %s"), *BulletHitResult.BoneName.ToString());
+	}
+	else
+	{
+		// Spawn impact particles
+		if (BulletImpactParticles && EmitterPool)
+		{
+			EmitterPool->SpawnEmitter(BulletImpactParticles, BulletHitResult.Location);
+		}
+	}
+
+	// Spawn trail particles
+	if (BulletTrailParticles && EmitterPool)
+	{
+		UParticleSystemComponent* Trail = EmitterPool->SpawnEmitter(BulletTrailParticles, SocketTransform);
+		if (Trail)
+		{
+			Trail->SetVectorParameter("Target", BulletHitResult.Location); // makes it so the particles appear in a line from TraceStart  to TrailEndPoint
 		}
 	}
 }
@@ -969,23 +1217,13 @@ void AProjectMarcusCharacter::ApplyWeaponKickback()
 	}
 }
 
-void AProjectMarcusCharacter::StartFireTimer()
-{
-	CombatState = ECombatState::ECS_FireTimerInProgress;
-
-	if (GetWorld())
-	{
-		GetWorld()->GetTimerManager().SetTimer(AutoFireTimeHandle, this, &AProjectMarcusCharacter::AutoFireReset, AutomaticFireRate);
-	}
-}
-
-bool AProjectMarcusCharacter::GetBulletHitLocation(const FVector BarrelSocketLocation, FHitResult& OutHit)
+bool AProjectMarcusCharacter::GetBulletHitLocation(const FVector BarrelSocketLocation, const FVector& CrosshairOrigin, const FVector& CrosshairDirection, FHitResult& OutHit)
 {
 	if (GetWorld())
 	{
 		FHitResult CrosshairHitResult;
 		FVector BeamLocation;
-		TraceFromCrosshairs(CrosshairHitResult, BeamLocation);
+		TraceFromCrosshairs(CrosshairOrigin, CrosshairDirection, CrosshairHitResult, BeamLocation);
 
 		// Trace from weapon barrel socket to whatever the crosshairs hit
 		const FVector BulletTraceStart = BarrelSocketLocation;
@@ -1006,28 +1244,15 @@ bool AProjectMarcusCharacter::GetBulletHitLocation(const FVector BarrelSocketLoc
 	return false;
 }
 
-bool AProjectMarcusCharacter::TraceFromCrosshairs(FHitResult& OutHitResult, FVector& OutHitLocation)
+bool AProjectMarcusCharacter::TraceFromCrosshairs(const FVector& CrosshairOrigin, const FVector& CrosshairDirection, FHitResult& OutHitResult, FVector& OutHitLocation)
 {
-	if (GEngine)
+	if (AProjectMarcusPlayerController* PMController = Cast<AProjectMarcusPlayerController>(GetController()))
 	{
-		FVector CrosshairLocationInWorld;
-		FVector CrosshairDirectionInWorld;
-		if (GetCrosshairWorldPosition(CrosshairLocationInWorld, CrosshairDirectionInWorld))
-		{
-			// 	Trace from crosshair pos in world outwards (in crosshair direction in world)
-			const FVector TraceStart = CrosshairLocationInWorld;
-			const FVector TraceEnd = CrosshairLocationInWorld + (CrosshairDirectionInWorld * TRACE_FAR);
-			OutHitLocation = TraceEnd;
-			if (GetWorld())
-			{
-				GetWorld()->LineTraceSingleByChannel(OutHitResult, TraceStart, TraceEnd, ECollisionChannel::ECC_Visibility);
-				if (OutHitResult.bBlockingHit)
-				{
-					OutHitLocation = OutHitResult.Location;
-					return true;
-				}
-			}
-		}
+		FCrosshairViewRay Ray;
+		Ray.Origin = CrosshairOrigin;
+		Ray.Direction = CrosshairDirection;
+		Ray.bValid = true;
+		return PMController->TraceFromCrosshairs(Ray, OutHitResult, OutHitLocation);
 	}
 
 	return false;
@@ -1035,27 +1260,22 @@ bool AProjectMarcusCharacter::TraceFromCrosshairs(FHitResult& OutHitResult, FVec
 
 bool AProjectMarcusCharacter::GetCrosshairWorldPosition(FVector& OutWorldPos, FVector& OutWorldDir)
 {
-	// Get viewport size
-	FVector2D ViewportSize;
-	GEngine->GameViewport->GetViewportSize(ViewportSize);
-
-	// Get screen space location of crosshairs
-	FVector2D CrosshairLocationOnScreen(ViewportSize.X / 2.f, ViewportSize.Y / 2.f);
-	CrosshairLocationOnScreen.Y -= CameraData.ScreenOffset.Y; // need to match offset in HUD
+	if (AProjectMarcusPlayerController* PMController = Cast<AProjectMarcusPlayerController>(GetController()))
+	{
+		const FCrosshairViewRay& CrosshairRay = PMController->GetCrosshairViewRay();
+		OutWorldPos = CrosshairRay.Origin;
+		OutWorldDir = CrosshairRay.Direction;
+		return CrosshairRay.bValid;
+	}
 
-	// Get world location and direction of crosshairs
-	return UGameplayStatics::DeprojectScreenToWorld(UGameplayStatics::GetPlayerController(this, LOCAL_USER_NUM), CrosshairLocationOnScreen, OutWorldPos, OutWorldDir);
+	return false;
 }
 
 bool AProjectMarcusCharacter::CarryingAmmoTypeForCurrentWeapon()
 {
 	if (EquippedWeapon)
 	{
-		EAmmoType CurAmmoType = EquippedWeapon->GetAmmoType();
-		if (AmmoStashMap.Contains(CurAmmoType))
-		{
-			return AmmoStashMap[CurAmmoType] > 0;
-		}
+		return AmmoStash.Has(EquippedWeapon->GetAmmoType());
 	}
 	return false;
 }
@@ -1080,6 +1300,29 @@ float AProjectMarcusCharacter::GetCrosshairSpreadMultiplier() const
 	return CrosshairSpreadMultiplier;
 }
 
+void AProjectMarcusCharacter::RefreshHUDViewModel()
+{
+	UHUDViewModel* HUDViewModel = GetHUDViewModel();
+	if (HUDViewModel == nullptr)
+	{
+		return;
+	}
+
+	if (EquippedWeapon)
+	{
+		HUDViewModel->SetClipAmmo(EquippedWeapon->GetAmmoInClip());
+		HUDViewModel->SetStashAmmo(AmmoStash.Get(EquippedWeapon->GetAmmoType()));
+		HUDViewModel->SetEquippedSlot(EquippedWeapon->GetInventorySlotIndex());
+	}
+	HUDViewModel->SetCrosshairSpread(CrosshairSpreadMultiplier);
+	HUDViewModel->SetFocusedItem(CurrentlyFocusedItem);
+}
+
+UHUDViewModel* AProjectMarcusCharacter::GetHUDViewModel() const
+{
+	return UHUDViewModel::Get(this);
+}
+
 bool AProjectMarcusCharacter::WeaponClipHasAmmo()
 {
 	if (EquippedWeapon)
@@ -4,7 +4,9 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
-#include "ProjectMarcus/AmmoType.h"
+#include "ProjectMarcus/AmmoLedger.h"
+#include "ProjectMarcus/Character/ItemFocusScoring.h"
+#include "ProjectMarcus/Combat/WeaponFireScheduler.h"
 #include "ProjectMarcusCharacter.generated.h"
 
 #ifndef LOCAL_USER_NUM
@@ -119,8 +121,7 @@ struct FPickupInterpLocationData
 	int32 NumItemsInterping;
 };
 
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FEquipItemDelegate, int32, CurrentSlotIdx, int32, NewSlotIdx);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FHighlightIconDelegate, int32, SlotIdx, bool, bStartAnimation);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FAmmoChangedDelegate, EAmmoType, AmmoType, int32, AmmoCount);
 
 UCLASS()
 class PROJECTMARCUS_API AProjectMarcusCharacter : public ACharacter
@@ -149,17 +150,24 @@ public:
 	UFUNCTION(BlueprintCallable)
 	int32 GetAmmoStashForType(EAmmoType AmmoType);
 
+	const FAmmoLedger& GetAmmoStash() const { return AmmoStash; }
+
 	ECombatState GetCombatState() const { return CombatState; }
 
 	// Get the location in world space for the requested PickupLocation
 	void GetPickupLocationLocation(int32 LocationIndex, FVector& OutPickupLocation);
 
+	int32 GetNumPickupLocations() const { return PickupLocations.Num(); }
+
 	// Finds the lowest filled pickup location, adds one to it's count, and returns the index
 	int32 AddItemToPickupLocation();
 
 	// Removes an item from the pickup location at LocationIndex
 	void RemoveItemFromPickupLocation(int32 LocationIndex);
 
+	// Damage, hit number and impact/trail VFX for a bullet that hit something. Used by both the sync and async hitscan paths
+	void ApplyBulletHit(const FHitResult& BulletHitResult, const FTransform& SocketTransform, float Damage, float HeadshotDamage);
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
@@ -235,10 +243,15 @@ protected:
 
 	void FireButtonReleased();
 
-	UFUNCTION()
-	void AutoFireReset();
+	// Fires every shot the scheduler owes this frame, and ends the fire cycle once the trigger is up (or the clip is dry) and the interval has run out
+	void UpdateAutoFire(float DeltaTime);
 
-	class AWeaponItem* SpawnDefaultWeapon();
+	void FinishFireCycle();
+
+	// Queued with the USpawnQueueSubsystem at critical priority, equipped in OnDefaultWeaponSpawned once it's live
+	void SpawnDefaultWeapon();
+
+	void OnDefaultWeaponSpawned(AActor* SpawnedActor);
 
 	// Attaches the given weapon to our character mesh
 	void EquipWeapon(class AWeaponItem* NewWeapon);
@@ -282,23 +295,33 @@ private:
 
 	void UpdateCurrentLookRate();
 
+	// Queries the world pickup index and adds/removes items that entered/left our pickup range
+	void UpdateItemsInRange();
+
 	void CheckForItemsInRange();
 
+	// Plays a one shot gunshot, or keeps the weapons fire loop running if it has one
 	void PlayBulletFireSfx();
 
-	void SendBulletWithVfx();
+	void StopFireLoopSfx();
 
-	void ApplyWeaponKickback();
+	// Fires ShotAges.Num() bullets this frame. Sound, kickback and crosshair kick play once no matter how many shots landed in the frame
+	void FireShots(const FWeaponFireScheduler::FShotAges& ShotAges, float DeltaTime);
+
+	// Traces every shot as one batch, each along the barrel/crosshair interpolated to its own sub-frame time, then applies the hits
+	void SendBullets(const FWeaponFireScheduler::FShotAges& ShotAges, float DeltaTime);
 
-	void StartFireTimer();
+	void ApplyWeaponKickback();
 
 	// After firing a bullet get it's final impact point (either hits something or goes off infinitively far)
 	// returns false only if there was an error during calculation
-	bool GetBulletHitLocation(const FVector BarrelSocketLocation, FHitResult& OutHit);
+	bool GetBulletHitLocation(const FVector BarrelSocketLocation, const FVector& CrosshairOrigin, const FVector& CrosshairDirection, FHitResult& OutHit);
 
 	// Line trace from crosshairs (in world space). OutHitResult contains a hit if one occurred. OUtHitLocation contains the ending trace location whether it hit something or not.
-	bool TraceFromCrosshairs(FHitResult& OutHitResult, FVector& OutHitLocation);
+	// Goes through the controllers cached crosshair trace
+	bool TraceFromCrosshairs(const FVector& CrosshairOrigin, const FVector& CrosshairDirection, FHitResult& OutHitResult, FVector& OutHitLocation);
 
+	// Reads the crosshair ray the controller cached this frame
 	bool GetCrosshairWorldPosition(FVector& OutWorldPos, FVector& OutWorldDir);
 
 	// Checks if the weapon's clip has ammo
@@ -331,6 +354,10 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
 	class UParticleSystem* MuzzleFlash;
 
+	// Resolve bullet traces on the physics worker (hits land a couple of frames later) instead of tracing on the game thread
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	bool bUseAsyncHitscan = false;
+
 	// Weapon fire montage
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
 	class UAnimMontage* HipFireMontage;
@@ -375,6 +402,10 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
 	class AWeaponItem* EquippedWeapon = nullptr;
 
+	// Voice playing the equipped weapons FireLoopSound while the trigger is held
+	UPROPERTY(Transient)
+	class UAudioComponent* FireLoopVoice = nullptr;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
 	TSubclassOf<AWeaponItem> DefaultWeaponClass;
 
@@ -383,9 +414,13 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
 	class AItemBase* CurrentlyFocusedItem = nullptr;
 
-	// TODO: Use a fixed length array instead
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
-	TMap<EAmmoType, int32> AmmoStashMap;
+	// Carried ammo per type, the caps are set here
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
+	FAmmoLedger AmmoStash;
+
+	// Sends the new count of every ammo type that changed, once per frame
+	UPROPERTY(BlueprintAssignable, Category = "Combat", meta = (AllowPrivateAccess = "true"))
+	FAmmoChangedDelegate AmmoChangedDelegate;
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
 	int32 Starting9mmAmmo = 0;
@@ -427,7 +462,22 @@ private:
 	bool bFireButtonPressed = false;
 	//bool bShouldFire = true;
 	float AutomaticFireRate = 0.1f; // automatic weapon fire rate (fire/second) - needs to be larger than ShootTimeDuration
-	FTimerHandle AutoFireTimeHandle;
+	FWeaponFireScheduler FireScheduler;
+
+	// Barrel and crosshair the way they were for a shot fired at the end of a frame
+	struct FFireView
+	{
+		FTransform SocketTransform;
+		FVector CrosshairOrigin = FVector::ZeroVector;
+		FVector CrosshairDirection = FVector::ForwardVector;
+		uint64 FrameNumber = 0;
+		bool bValid = false;
+	};
+
+	bool GetFireView(FFireView& OutView);
+
+	// Captured every frame while firing, shots in the next frame interpolate from here
+	FFireView LastFireView;
 
 	// Used for zooming the camera in/out when aiming
 	bool bIsAiming = false;
@@ -442,30 +492,42 @@ private:
 	// Cache of any items we are in range of 
 	UPROPERTY()
 	TMap<uint32, TWeakObjectPtr<class AItemBase>> ItemsInRange;
+	// Reused every frame for the pickup index query results, and their ids for the diff against ItemsInRange
+	TArray<AItemBase*> ItemRangeQueryResults;
+	TSet<uint32> ItemRangeQueryIds;
+	// Radius around the character that items are considered in range for focusing/pickup
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Items", meta = (AllowPrivateAccess = "true"))
+	float ItemPickupRange = 250.f;
 	// Threshold for how close the player needs to look at (1 = directly at it, 0.5 = 50% between looking and not...etc)
 	float ItemPopupVisibilityThreshold = 0.99f;
-
+	// Favors closer items when several are lined up under the crosshair (penalty per ItemPickupRange of distance)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Items", meta = (AllowPrivateAccess = "true"))
+	float ItemFocusDistanceWeight = 0.005f;
+	// How much look amount the focused item can lose before focus drops/moves to another item. Stops focus flickering between neighbours
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Items", meta = (AllowPrivateAccess = "true"))
+	float ItemFocusHysteresis = 0.003f;
+	// Per frame copies of the items in range for focus scoring (FocusCandidateItems[i] is at FocusCandidates lane i)
+	FItemFocusCandidates FocusCandidates;
+	TArray<AItemBase*> FocusCandidateItems;
+
+	// Weapon slots, and the equip/highlight events for the inventory bar
 	UPROPERTY(VisibleAnywhere, BlueprintReadonly, Category = "Inventory", meta = (AllowPrivateAccess = "true"))
-	TArray<AItemBase*> Inventory;
-	const int INVENTORY_CAPACITY = 6;
-
-	// Sends slot info to inventory bar when equipping
-	UPROPERTY(BlueprintAssignable, Category = "Inventory", meta = (AllowPrivateAccess = "true"))
-	FEquipItemDelegate EquipItemDelegate;
-
-	// Sends which index in the inventory should be highlighted
-	UPROPERTY(BlueprintAssignable, Category = "Inventory", meta = (AllowPrivateAccess = "true"))
-	FHighlightIconDelegate HighlightIconDelegate;
-
-	// Index for the currently highlighted slot
-	UPROPERTY(VisibleAnywhere, BlueprintReadonly, Category = "Inventory", meta = (AllowPrivateAccess = "true"))
-	int32 HighlightedSlot = -1;
+	class UInventoryComponent* Inventory;
 
 public:
 	FORCEINLINE USpringArmComponent* GetCameraArm() const { return CameraArm; }
 	FORCEINLINE UCameraComponent* GetFollowCamera() const { return FollowCam; }
 	FORCEINLINE bool IsAiming() const { return bIsAiming; }
+	FORCEINLINE UInventoryComponent* GetInventory() const { return Inventory; }
+	// Vertical offset of the crosshair from the middle of the screen (matches the HUD)
+	FORCEINLINE float GetCrosshairScreenOffset() const { return CameraData.ScreenOffset.Y; }
 	
 	UFUNCTION(BlueprintCallable)
 	float GetCrosshairSpreadMultiplier() const;
+
+	// Pushes every HUD field (ammo, spread, equipped slot, focused item) to the controller's view model
+	void RefreshHUDViewModel();
+
+private:
+	class UHUDViewModel* GetHUDViewModel() const;
 };
@@ -0,0 +1,154 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Combat/AsyncHitscanSubsystem.h"
+#include "ProjectMarcus/Character/ProjectMarcusCharacter.h"
+#include "ProjectMarcus/ProjectMarcus.h"
+
+DECLARE_CYCLE_STAT(TEXT("Async Hitscan"), STAT_AsyncHitscan, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Async Hitscan Shots"), STAT_AsyncHitscanShots, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Async Hitscan Sync Fallbacks"), STAT_AsyncHitscanFallbacks, STATGROUP_ProjectMarcus);
+
+void UAsyncHitscanSubsystem::Deinitialize()
+{
+	Shots.Empty();
+
+	Super::Deinitialize();
+}
+
+void UAsyncHitscanSubsystem::QueueShot(AProjectMarcusCharacter* Shooter, const FTransform& SocketTransform, const FVector& CrosshairOrigin, const FVector& CrosshairDirection, float Damage, float HeadshotDamage)
+{
+	UWorld* World = GetWorld();
+	if (Shooter == nullptr || World == nullptr)
+	{
+		return;
+	}
+
+	FQueuedShot& Shot = Shots.AddDefaulted_GetRef();
+	Shot.Shooter = Shooter;
+	Shot.SocketTransform = SocketTransform;
+	Shot.CrosshairOrigin = CrosshairOrigin;
+	Shot.CrosshairEnd = CrosshairOrigin + CrosshairDirection * TRACE_FAR;
+	Shot.Damage = Damage;
+	Shot.HeadshotDamage = HeadshotDamage;
+	Shot.Stage = EShotStage::Crosshair;
+	Shot.TraceHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, CrosshairOrigin, Shot.CrosshairEnd, ECollisionChannel::ECC_Visibility);
+	Shot.TraceFrame = GFrameCounter;
+
+	INC_DWORD_STAT(STAT_AsyncHitscanShots);
+}
+
+void UAsyncHitscanSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AsyncHitscan);
+
+	if (Shots.Num() == 0)
+	{
+		return;
+	}
+
+	for (FQueuedShot& Shot : Shots)
+	{
+		AdvanceShot(Shot);
+	}
+
+	// Apply from the front only, a later shot never lands before an earlier one
+	int32 NumApplied = 0;
+	for (; NumApplied < Shots.Num(); ++NumApplied)
+	{
+		FQueuedShot& Shot = Shots[NumApplied];
+		if (Shot.Stage != EShotStage::Resolved)
+		{
+			break;
+		}
+
+		AProjectMarcusCharacter* Shooter = Shot.Shooter.Get();
+		if (Shooter && Shot.BulletHit.bBlockingHit)
+		{
+			Shooter->ApplyBulletHit(Shot.BulletHit, Shot.SocketTransform, Shot.Damage, Shot.HeadshotDamage);
+		}
+	}
+	Shots.RemoveAt(0, NumApplied, false);
+}
+
+TStatId UAsyncHitscanSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAsyncHitscanSubsystem, STATGROUP_Tickables);
+}
+
+void UAsyncHitscanSubsystem::AdvanceShot(FQueuedShot& Shot)
+{
+	// Results are only available the frame after the request
+	if (Shot.Stage == EShotStage::Resolved || Shot.TraceFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	if (!Shot.Shooter.IsValid())
+	{
+		Shot.BulletHit = FHitResult();
+		Shot.Stage = EShotStage::Resolved;
+		return;
+	}
+
+	bool bReady = false;
+	if (Shot.Stage == EShotStage::Crosshair)
+	{
+		FHitResult CrosshairHit;
+		GetTraceResult(Shot.TraceHandle, Shot.CrosshairOrigin, Shot.CrosshairEnd, CrosshairHit, bReady);
+		if (bReady)
+		{
+			Shot.BeamLocation = CrosshairHit.bBlockingHit ? CrosshairHit.Location : Shot.CrosshairEnd;
+			StartBulletTrace(Shot);
+		}
+	}
+	else if (Shot.Stage == EShotStage::Bullet)
+	{
+		GetTraceResult(Shot.TraceHandle, Shot.SocketTransform.GetLocation(), Shot.BulletTraceEnd, Shot.BulletHit, bReady);
+		if (bReady)
+		{
+			if (!Shot.BulletHit.bBlockingHit)
+			{
+				// Bullet didn't hit anything so send location of where the beam was sent
+				Shot.BulletHit.Location = Shot.BeamLocation;
+			}
+			Shot.Stage = EShotStage::Resolved;
+		}
+	}
+}
+
+void UAsyncHitscanSubsystem::StartBulletTrace(FQueuedShot& Shot)
+{
+	// Trace from weapon barrel socket to whatever the crosshairs hit, increased further by 25%
+	const FVector BulletTraceStart = Shot.SocketTransform.GetLocation();
+	Shot.BulletTraceEnd = BulletTraceStart + (Shot.BeamLocation - BulletTraceStart) * 1.25f;
+	Shot.TraceHandle = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, BulletTraceStart, Shot.BulletTraceEnd, ECollisionChannel::ECC_Visibility);
+	Shot.TraceFrame = GFrameCounter;
+	Shot.Stage = EShotStage::Bullet;
+}
+
+bool UAsyncHitscanSubsystem::GetTraceResult(const FTraceHandle& Handle, const FVector& Start, const FVector& End, FHitResult& OutHit, bool& bOutReady)
+{
+	OutHit = FHitResult();
+	bOutReady = false;
+
+	FTraceDatum TraceData;
+	if (GetWorld()->QueryTraceData(Handle, TraceData))
+	{
+		bOutReady = true;
+		if (TraceData.OutHits.Num() > 0)
+		{
+			OutHit = TraceData.OutHits[0];
+		}
+		return OutHit.bBlockingHit;
+	}
+
+	// The engine only keeps two frames of async results. If we missed them (hitch, paused tick) trace now instead of losing the shot
+	if (!GetWorld()->IsTraceHandleValid(Handle, false))
+	{
+		INC_DWORD_STAT(STAT_AsyncHitscanFallbacks);
+		bOutReady = true;
+		return GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility);
+	}
+
+	return false;
+}
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProjectMarcus/Subsystems/ProjectMarcusTickableSubsystem.h"
+#include "WorldCollision.h"
+#include "AsyncHitscanSubsystem.generated.h"
+
+/**
+ * Resolves weapon hitscan off the game thread using the engines async traces.
+ * Each shot runs the crosshair ray, then the barrel-to-target ray, each stage resolving on the physics worker and being
+ * picked up the following frame. Shots are kept in the order they were fired and hits are only applied from the front,
+ * so the result doesn't depend on which trace finished first.
+ */
+UCLASS()
+class PROJECTMARCUS_API UAsyncHitscanSubsystem : public UProjectMarcusTickableSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Queues a shot fired from SocketTransform along the crosshair ray. Damage is captured now so swapping weapons mid flight doesn't change it
+	void QueueShot(class AProjectMarcusCharacter* Shooter, const FTransform& SocketTransform, const FVector& CrosshairOrigin, const FVector& CrosshairDirection, float Damage, float HeadshotDamage);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	enum class EShotStage : uint8
+	{
+		Crosshair,
+		Bullet,
+		Resolved
+	};
+
+	struct FQueuedShot
+	{
+		TWeakObjectPtr<AProjectMarcusCharacter> Shooter;
+		FTransform SocketTransform;
+		FVector CrosshairOrigin = FVector::ZeroVector;
+		FVector CrosshairEnd = FVector::ZeroVector;
+		FVector BeamLocation = FVector::ZeroVector;
+		FVector BulletTraceEnd = FVector::ZeroVector;
+		float Damage = 0.f;
+		float HeadshotDamage = 0.f;
+		EShotStage Stage = EShotStage::Crosshair;
+		FTraceHandle TraceHandle;
+		// GFrameCounter the current trace was requested on
+		uint64 TraceFrame = 0;
+		FHitResult BulletHit;
+	};
+
+	// Moves the shot on a stage if its trace has resolved
+	void AdvanceShot(FQueuedShot& Shot);
+
+	void StartBulletTrace(FQueuedShot& Shot);
+
+	// Fetches the single trace result for Handle. Falls back to a sync trace if the async data has already been thrown away
+	bool GetTraceResult(const FTraceHandle& Handle, const FVector& Start, const FVector& End, FHitResult& OutHit, bool& bOutReady);
+
+	// In fire order
+	TArray<FQueuedShot> Shots;
+};
@@ -0,0 +1,251 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Combat/DamageQueueSubsystem.h"
+#include "ProjectMarcus/ProjectMarcus.h"
+
+DECLARE_CYCLE_STAT(TEXT("Damage Queue Resolve"), STAT_DamageQueueResolve, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Events"), STAT_DamageEvents, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damaged Targets"), STAT_DamagedTargets, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Damageables"), STAT_Damageables, STATGROUP_ProjectMarcus);
+
+void FDamageQueueTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem)
+	{
+		Subsystem->ResolveDamage();
+	}
+}
+
+FString FDamageQueueTickFunction::DiagnosticMessage()
+{
+	return TEXT("FDamageQueueTickFunction");
+}
+
+void UDamageQueueSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (!InWorld.IsGameWorld())
+	{
+		return;
+	}
+
+	// Everything fired in the pre physics group (the player, AI) lands in the same frame, before the camera update projects hit numbers
+	TickFunction.Subsystem = this;
+	TickFunction.bCanEverTick = true;
+	TickFunction.TickGroup = TG_PostPhysics;
+	TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UDamageQueueSubsystem::Deinitialize()
+{
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.UnRegisterTickFunction();
+	}
+	TickFunction.Subsystem = nullptr;
+
+	DEC_DWORD_STAT_BY(STAT_Damageables, Targets.Num());
+	Targets.Empty();
+	TargetKeys.Empty();
+	TargetItems.Empty();
+	Damageables.Empty();
+	Health.Empty();
+	MaxHealth.Empty();
+	ResolvedSlots.Empty();
+	TargetIndices.Empty();
+	QueuedDamage.Empty();
+	ResolvingDamage.Empty();
+
+	Super::Deinitialize();
+}
+
+void UDamageQueueSubsystem::RegisterTarget(AActor* Target, float InMaxHealth, float InHealth, int32 Item)
+{
+	IDamageableInterface* Damageable = Cast<IDamageableInterface>(Target);
+	if (Damageable == nullptr)
+	{
+		return;
+	}
+
+	int32 Index = FindTargetIndex(Target, Item);
+	if (Index == INDEX_NONE)
+	{
+		Index = Targets.Add(Target);
+		TargetKeys.Add(MakeTargetKey(Target, Item));
+		TargetItems.Add(Item);
+		Damageables.Add(Damageable);
+		Health.AddZeroed();
+		MaxHealth.AddZeroed();
+		ResolvedSlots.Add(INDEX_NONE);
+		TargetIndices.Add(TargetKeys[Index], Index);
+		INC_DWORD_STAT(STAT_Damageables);
+	}
+
+	MaxHealth[Index] = FMath::Max(InMaxHealth, 0.f);
+	Health[Index] = FMath::Clamp(InHealth, 0.f, MaxHealth[Index]);
+}
+
+void UDamageQueueSubsystem::UnregisterTarget(AActor* Target, int32 Item)
+{
+	int32 Index = INDEX_NONE;
+	if (Target == nullptr || !TargetIndices.RemoveAndCopyValue(MakeTargetKey(Target, Item), Index))
+	{
+		return;
+	}
+
+	if (bResolving)
+	{
+		// A target dying in its own callback, keep the arrays still until the pass is done
+		Targets[Index].Reset();
+		Damageables[Index] = nullptr;
+		PendingRemovals.Add(Index);
+		return;
+	}
+
+	RemoveTargetAt(Index);
+}
+
+void UDamageQueueSubsystem::QueueDamage(AActor* Target, float Damage, const FVector& HitLocation, bool bHeadshot, AController* Instigator, AActor* DamageCauser, int32 Item)
+{
+	const int32 Index = FindTargetIndex(Target, Item);
+	if (Index == INDEX_NONE || Damage <= 0.f)
+	{
+		return;
+	}
+
+	FQueuedDamage& Queued = QueuedDamage.AddDefaulted_GetRef();
+	Queued.TargetIndex = Index;
+	Queued.Damage = Damage;
+	Queued.HitLocation = HitLocation;
+	Queued.bHeadshot = bHeadshot;
+	Queued.Instigator = Instigator;
+	Queued.DamageCauser = DamageCauser;
+}
+
+float UDamageQueueSubsystem::GetHealth(const AActor* Target, int32 Item) const
+{
+	const int32 Index = FindTargetIndex(Target, Item);
+	return Index == INDEX_NONE ? 0.f : Health[Index];
+}
+
+float UDamageQueueSubsystem::GetMaxHealth(const AActor* Target, int32 Item) const
+{
+	const int32 Index = FindTargetIndex(Target, Item);
+	return Index == INDEX_NONE ? 0.f : MaxHealth[Index];
+}
+
+void UDamageQueueSubsystem::ResolveDamage()
+{
+	if (QueuedDamage.Num() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_DamageQueueResolve);
+	INC_DWORD_STAT_BY(STAT_DamageEvents, QueuedDamage.Num());
+
+	// Anything queued from inside a callback (e.g. an explosion) goes to next frames pass
+	Swap(QueuedDamage, ResolvingDamage);
+	bResolving = true;
+
+	// Sum every hit per target and apply it to health
+	for (const FQueuedDamage& Queued : ResolvingDamage)
+	{
+		const int32 Index = Queued.TargetIndex;
+		if (Index == INDEX_NONE || Damageables[Index] == nullptr || Health[Index] <= 0.f)
+		{
+			// Unregistered since, or already dead
+			continue;
+		}
+
+		int32& Slot = ResolvedSlots[Index];
+		if (Slot == INDEX_NONE)
+		{
+			Slot = ResolvedDamage.AddDefaulted();
+			ResolvedTargets.Add(Index);
+		}
+
+		FResolvedDamage& Resolved = ResolvedDamage[Slot];
+		Health[Index] = FMath::Clamp(Health[Index] - Queued.Damage, 0.f, MaxHealth[Index]);
+		Resolved.TotalDamage += Queued.Damage;
+		Resolved.NumHits++;
+		Resolved.HitLocation = Queued.HitLocation;
+		Resolved.bHeadshot |= Queued.bHeadshot;
+		Resolved.Instigator = Queued.Instigator.Get();
+		Resolved.DamageCauser = Queued.DamageCauser.Get();
+		Resolved.bKilled = Health[Index] <= 0.f;
+	}
+
+	INC_DWORD_STAT_BY(STAT_DamagedTargets, ResolvedTargets.Num());
+
+	// One callback per target, deaths included
+	for (int32 Slot = 0; Slot < ResolvedTargets.Num(); ++Slot)
+	{
+		const int32 Index = ResolvedTargets[Slot];
+		ResolvedSlots[Index] = INDEX_NONE;
+
+		FResolvedDamage& Resolved = ResolvedDamage[Slot];
+		Resolved.Health = Health[Index];
+		Resolved.MaxHealth = MaxHealth[Index];
+		Resolved.Item = TargetItems[Index];
+
+		if (Damageables[Index] && Targets[Index].IsValid())
+		{
+			Damageables[Index]->OnDamageResolved(Resolved);
+		}
+	}
+
+	ResolvedDamage.Reset();
+	ResolvedTargets.Reset();
+	ResolvingDamage.Reset();
+	bResolving = false;
+
+	// Highest index first so removing one never moves another pending one
+	PendingRemovals.Sort(TGreater<int32>());
+	for (const int32 Index : PendingRemovals)
+	{
+		RemoveTargetAt(Index);
+	}
+	PendingRemovals.Reset();
+}
+
+int32 UDamageQueueSubsystem::FindTargetIndex(const AActor* Target, int32 Item) const
+{
+	const int32* Index = Target ? TargetIndices.Find(MakeTargetKey(Target, Item)) : nullptr;
+	return Index ? *Index : INDEX_NONE;
+}
+
+void UDamageQueueSubsystem::RemoveTargetAt(int32 Index)
+{
+	const int32 LastIndex = Targets.Num() - 1;
+	if (Index != LastIndex)
+	{
+		// The last target moves into the hole, point its id and anything queued for it at the new index
+		if (int32* MovedIndex = TargetIndices.Find(TargetKeys[LastIndex]))
+		{
+			*MovedIndex = Index;
+		}
+	}
+
+	for (FQueuedDamage& Queued : QueuedDamage)
+	{
+		if (Queued.TargetIndex == Index)
+		{
+			Queued.TargetIndex = INDEX_NONE;
+		}
+		else if (Queued.TargetIndex == LastIndex)
+		{
+			Queued.TargetIndex = Index;
+		}
+	}
+
+	Targets.RemoveAtSwap(Index, 1, false);
+	TargetKeys.RemoveAtSwap(Index, 1, false);
+	TargetItems.RemoveAtSwap(Index, 1, false);
+	Damageables.RemoveAtSwap(Index, 1, false);
+	Health.RemoveAtSwap(Index, 1, false);
+	MaxHealth.RemoveAtSwap(Index, 1, false);
+	ResolvedSlots.RemoveAtSwap(Index, 1, false);
+	DEC_DWORD_STAT(STAT_Damageables);
+}
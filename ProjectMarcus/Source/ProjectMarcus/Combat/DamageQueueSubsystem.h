@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ProjectMarcus/Interfaces/DamageableInterface.h"
+#include "DamageQueueSubsystem.generated.h"
+
+// Runs the damage queue once per frame in TG_PostPhysics
+USTRUCT()
+struct FDamageQueueTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	class UDamageQueueSubsystem* Subsystem = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FDamageQueueTickFunction> : public TStructOpsTypeTraitsBase2<FDamageQueueTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * Owns the health of every registered damageable and applies damage in one pass per frame.
+ * Hits are only queued when they happen; the pass sums them per target, updates health in one dense array and
+ * calls IDamageableInterface::OnDamageResolved once per target, so five bullets in a frame give one hit number,
+ * one health bar update and at most one death.
+ */
+UCLASS()
+class PROJECTMARCUS_API UDamageQueueSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// Target must implement IDamageableInterface. An actor can register several Items, each with its own health
+	void RegisterTarget(AActor* Target, float MaxHealth, float Health, int32 Item = INDEX_NONE);
+
+	void UnregisterTarget(AActor* Target, int32 Item = INDEX_NONE);
+
+	// Applied in this frames damage pass (next frames if the pass already ran)
+	void QueueDamage(AActor* Target, float Damage, const FVector& HitLocation, bool bHeadshot, AController* Instigator, AActor* DamageCauser, int32 Item = INDEX_NONE);
+
+	bool IsRegistered(const AActor* Target, int32 Item = INDEX_NONE) const { return FindTargetIndex(Target, Item) != INDEX_NONE; }
+
+	// 0 for targets that aren't registered
+	float GetHealth(const AActor* Target, int32 Item = INDEX_NONE) const;
+	float GetMaxHealth(const AActor* Target, int32 Item = INDEX_NONE) const;
+
+	// Sums and applies everything queued since the last pass
+	void ResolveDamage();
+
+private:
+	struct FQueuedDamage
+	{
+		int32 TargetIndex = INDEX_NONE;
+		float Damage = 0.f;
+		FVector HitLocation = FVector::ZeroVector;
+		bool bHeadshot = false;
+		TWeakObjectPtr<AController> Instigator;
+		TWeakObjectPtr<AActor> DamageCauser;
+	};
+
+	static uint64 MakeTargetKey(const AActor* Target, int32 Item) { return (static_cast<uint64>(Target->GetUniqueID()) << 32) | static_cast<uint32>(Item); }
+
+	int32 FindTargetIndex(const AActor* Target, int32 Item) const;
+
+	void RemoveTargetAt(int32 Index);
+
+	FDamageQueueTickFunction TickFunction;
+
+	// Dense per target arrays, all indexed the same
+	TArray<TWeakObjectPtr<AActor>> Targets;
+	TArray<uint64> TargetKeys;
+	TArray<int32> TargetItems;
+	TArray<IDamageableInterface*> Damageables;
+	TArray<float> Health;
+	TArray<float> MaxHealth;
+	// Index into ResolvedDamage while a pass is running
+	TArray<int32> ResolvedSlots;
+
+	// Target unique id + item -> index into the arrays above
+	TMap<uint64, int32> TargetIndices;
+
+	TArray<FQueuedDamage> QueuedDamage;
+	// What the running pass is working through, swapped with QueuedDamage so neither reallocates
+	TArray<FQueuedDamage> ResolvingDamage;
+
+	// Reused by every pass
+	TArray<FResolvedDamage> ResolvedDamage;
+	TArray<int32> ResolvedTargets;
+
+	// Targets unregistered while a pass was running, removed once it's done so indices stay put during the pass
+	TArray<int32> PendingRemovals;
+	bool bResolving = false;
+};
@@ -0,0 +1,202 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Combat/ExplosionSubsystem.h"
+#include "ProjectMarcus/Combat/DamageQueueSubsystem.h"
+#include "ProjectMarcus/Interactables/ItemBase.h"
+#include "ProjectMarcus/Interactables/ItemSpatialSubsystem.h"
+#include "ProjectMarcus/Subsystems/CombatAudioSubsystem.h"
+#include "ProjectMarcus/Subsystems/EmitterPoolSubsystem.h"
+#include "ProjectMarcus/ProjectMarcus.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "WorldCollision.h"
+
+DECLARE_CYCLE_STAT(TEXT("Explosions"), STAT_Explosions, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosions Processed"), STAT_ExplosionsProcessed, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosions Deferred"), STAT_ExplosionsDeferred, STATGROUP_ProjectMarcus);
+
+float FExplosionParams::GetDamageAtDistance(float Distance) const
+{
+	if (Distance <= InnerRadius)
+	{
+		return BaseDamage;
+	}
+	if (Distance > Radius)
+	{
+		return 0.f;
+	}
+
+	const float Alpha = FMath::Clamp((Distance - InnerRadius) / FMath::Max(Radius - InnerRadius, KINDA_SMALL_NUMBER), 0.f, 1.f);
+	return FMath::Lerp(BaseDamage, MinimumDamage, FMath::Pow(Alpha, 1.f / FMath::Max(DamageFalloff, KINDA_SMALL_NUMBER)));
+}
+
+void UExplosionSubsystem::Deinitialize()
+{
+	Queue.Empty();
+	QueueHead = 0;
+	Overlaps.Empty();
+	DamagedTargets.Empty();
+	ItemsInRadius.Empty();
+
+	Super::Deinitialize();
+}
+
+void UExplosionSubsystem::QueueExplosion(const FExplosionRequest& Request)
+{
+	Queue.Add(Request);
+}
+
+void UExplosionSubsystem::Tick(float DeltaTime)
+{
+	if (QueueHead >= Queue.Num())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_Explosions);
+
+	const int32 NumExploded = ProcessQueue(FrameBudgetMs, MinExplosionsPerFrame, [this](const FExplosionRequest& Request) { Explode(Request); });
+
+	INC_DWORD_STAT_BY(STAT_ExplosionsProcessed, NumExploded);
+	INC_DWORD_STAT_BY(STAT_ExplosionsDeferred, GetNumQueued());
+}
+
+int32 UExplosionSubsystem::ProcessQueue(float BudgetMs, int32 MinExplosions, TFunctionRef<void(const FExplosionRequest&)> ExplodeFunc)
+{
+	// Only what's queued right now, anything an explosion sets off this frame waits for the damage pass anyway
+	const int32 QueueEnd = Queue.Num();
+	const double EndTime = FPlatformTime::Seconds() + BudgetMs / 1000.0;
+
+	int32 NumExploded = 0;
+	while (QueueHead < QueueEnd)
+	{
+		if (NumExploded >= MinExplosions && FPlatformTime::Seconds() >= EndTime)
+		{
+			break;
+		}
+
+		// Copy out, exploding can append to the queue
+		const FExplosionRequest Request = Queue[QueueHead++];
+		ExplodeFunc(Request);
+		++NumExploded;
+	}
+
+	// Drop the consumed front once it's most of the array, so the FIFO doesn't shuffle memory every frame
+	if (QueueHead == Queue.Num())
+	{
+		Queue.Reset();
+		QueueHead = 0;
+	}
+	else if (QueueHead > Queue.Num() / 2)
+	{
+		Queue.RemoveAt(0, QueueHead, false);
+		QueueHead = 0;
+	}
+
+	return NumExploded;
+}
+
+TStatId UExplosionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UExplosionSubsystem, STATGROUP_Tickables);
+}
+
+void UExplosionSubsystem::Explode(const FExplosionRequest& Request)
+{
+	UWorld* World = GetWorld();
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	const FExplosionParams& Params = Request.Params;
+	AActor* DamageCauser = Request.DamageCauser.Get();
+	AController* Instigator = Request.Instigator.Get();
+
+	UEmitterPoolSubsystem* EmitterPool = World->GetSubsystem<UEmitterPoolSubsystem>();
+	if (Request.Particles.IsValid() && EmitterPool)
+	{
+		EmitterPool->SpawnEmitter(Request.Particles.Get(), Request.Origin);
+	}
+
+	UCombatAudioSubsystem* CombatAudio = World->GetSubsystem<UCombatAudioSubsystem>();
+	if (Request.Sound.IsValid() && CombatAudio)
+	{
+		CombatAudio->PlaySoundAtLocation(Request.Sound.Get(), Request.Origin, ECombatSoundCategory::ECSC_Explosion, 3.f);
+	}
+
+	// Enemies, props and anything simulating physics
+	FCollisionObjectQueryParams ObjectParams;
+	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
+	ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+	ObjectParams.AddObjectTypesToQuery(ECC_PhysicsBody);
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ExplosionOverlap), false, DamageCauser);
+
+	Overlaps.Reset();
+	World->OverlapMultiByObjectType(Overlaps, Request.Origin, FQuat::Identity, ObjectParams, FCollisionShape::MakeSphere(Params.Radius), QueryParams);
+
+	UDamageQueueSubsystem* DamageQueue = World->GetSubsystem<UDamageQueueSubsystem>();
+
+	DamagedTargets.Reset();
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		UPrimitiveComponent* Component = Overlap.GetComponent();
+		if (Component && Component->IsSimulatingPhysics())
+		{
+			Component->AddRadialImpulse(Request.Origin, Params.Radius, Params.ImpulseStrength, ERadialImpulseFalloff::RIF_Linear, true);
+		}
+
+		AActor* Actor = Overlap.GetActor();
+		if (Actor == nullptr)
+		{
+			continue;
+		}
+
+		// Targets with per item health (instanced props) are damaged per overlapping instance
+		const IDamageableInterface* Damageable = Cast<IDamageableInterface>(Actor);
+		const int32 DamageItem = Damageable ? Damageable->GetDamageItem(Component, Overlap.ItemIndex) : INDEX_NONE;
+
+		// An actor can overlap with several components, only damage/launch it once
+		const TPair<AActor*, int32> Target(Actor, DamageItem);
+		if (DamagedTargets.Contains(Target))
+		{
+			continue;
+		}
+		DamagedTargets.Add(Target);
+
+		if (ACharacter* Character = Cast<ACharacter>(Actor))
+		{
+			if (UCharacterMovementComponent* MoveComp = Character->GetCharacterMovement())
+			{
+				MoveComp->AddRadialImpulse(Request.Origin, Params.Radius, Params.ImpulseStrength, ERadialImpulseFalloff::RIF_Linear, true);
+			}
+		}
+
+		if (DamageQueue && DamageQueue->IsRegistered(Actor, DamageItem))
+		{
+			FVector TargetLocation = Actor->GetActorLocation();
+			const UInstancedStaticMeshComponent* InstancedMesh = Cast<UInstancedStaticMeshComponent>(Component);
+			FTransform InstanceTransform;
+			if (DamageItem != INDEX_NONE && InstancedMesh && InstancedMesh->GetInstanceTransform(Overlap.ItemIndex, InstanceTransform, true))
+			{
+				TargetLocation = InstanceTransform.GetLocation();
+			}
+
+			const float Damage = Params.GetDamageAtDistance(FVector::Dist(Request.Origin, TargetLocation));
+			DamageQueue->QueueDamage(Actor, Damage, TargetLocation, false, Instigator, DamageCauser, DamageItem);
+		}
+	}
+
+	// Items waiting for pickup have no collision, they're only in the pickup index
+	if (UItemSpatialSubsystem* ItemIndex = World->GetSubsystem<UItemSpatialSubsystem>())
+	{
+		ItemsInRadius.Reset();
+		ItemIndex->QueryItemsInRadius(Request.Origin, Params.Radius, ItemsInRadius);
+		for (AItemBase* Item : ItemsInRadius)
+		{
+			Item->ApplyKnockback(Request.Origin, Params.Radius, Params.ImpulseStrength);
+		}
+	}
+}
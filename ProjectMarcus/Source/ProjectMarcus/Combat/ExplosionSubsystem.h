@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProjectMarcus/Subsystems/ProjectMarcusTickableSubsystem.h"
+#include "WorldCollision.h"
+#include "ExplosionSubsystem.generated.h"
+
+// Radial damage and impulse of one explosion
+USTRUCT(BlueprintType)
+struct FExplosionParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Explosion")
+	float Radius = 500.f;
+
+	// Full damage inside this radius, falls off from here out to Radius
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Explosion")
+	float InnerRadius = 100.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Explosion")
+	float BaseDamage = 100.f;
+
+	// Damage right at the edge of Radius
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Explosion")
+	float MinimumDamage = 10.f;
+
+	// 1 is linear, higher drops off faster near the inner radius
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Explosion")
+	float DamageFalloff = 1.f;
+
+	// Velocity change (cm/s) at the center, falls off linearly to 0 at Radius
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Explosion")
+	float ImpulseStrength = 1500.f;
+
+	float GetDamageAtDistance(float Distance) const;
+};
+
+/**
+ * Runs explosions from a FIFO with a per frame time budget.
+ * An explosion damages everything registered with the UDamageQueueSubsystem in its radius, so a prop it kills queues
+ * its own explosion from the damage pass. That makes chain reactions breadth first (every explosion of one ring goes
+ * off before any of the next), and a room full of barrels spreads over as many frames as it needs instead of one.
+ */
+UCLASS(Config = Game)
+class PROJECTMARCUS_API UExplosionSubsystem : public UProjectMarcusTickableSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	struct FExplosionRequest
+	{
+		FVector Origin = FVector::ZeroVector;
+		FExplosionParams Params;
+		TWeakObjectPtr<class UParticleSystem> Particles;
+		TWeakObjectPtr<class USoundBase> Sound;
+		TWeakObjectPtr<AActor> DamageCauser;
+		TWeakObjectPtr<AController> Instigator;
+	};
+
+	virtual void Deinitialize() override;
+
+	// Goes off once everything queued before it has
+	void QueueExplosion(const FExplosionRequest& Request);
+
+	int32 GetNumQueued() const { return Queue.Num() - QueueHead; }
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// One frame of the queue: runs what's queued right now through ExplodeFunc until BudgetMs is used up (at least
+	// MinExplosions of them). Tick passes Explode, tests pass their own. Returns how many went off
+	int32 ProcessQueue(float BudgetMs, int32 MinExplosions, TFunctionRef<void(const FExplosionRequest&)> ExplodeFunc);
+
+private:
+	void Explode(const FExplosionRequest& Request);
+
+	// Milliseconds per frame spent on explosions. Whatever is left over goes off next frame
+	UPROPERTY(Config)
+	float FrameBudgetMs = 1.f;
+
+	// Always run at least this many per frame so a slow frame can't stall the queue
+	UPROPERTY(Config)
+	int32 MinExplosionsPerFrame = 1;
+
+	// FIFO, QueueHead is the next one to go off
+	TArray<FExplosionRequest> Queue;
+	int32 QueueHead = 0;
+
+	// Reused for every explosions query
+	TArray<FOverlapResult> Overlaps;
+	TArray<TPair<AActor*, int32>> DamagedTargets;
+	TArray<class AItemBase*> ItemsInRadius;
+};
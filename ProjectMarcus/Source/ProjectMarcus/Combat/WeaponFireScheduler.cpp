@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Combat/WeaponFireScheduler.h"
+
+void FWeaponFireScheduler::FireNow()
+{
+	TimeSinceLastShot = 0.f;
+	bFiredOutsideAdvance = true;
+}
+
+int32 FWeaponFireScheduler::Advance(float DeltaTime, int32 MaxShots, FShotAges& OutShotAges)
+{
+	if (bFiredOutsideAdvance)
+	{
+		// The shot fired this frame is the reference point, the frame time before it belongs to nothing
+		bFiredOutsideAdvance = false;
+		DeltaTime = 0.f;
+	}
+
+	// Don't let the clock run away while idle, and don't unload a huge burst after a hitch
+	const float MaxTime = MaxShots > 0 ? FireInterval + MaxCatchUpTime : FireInterval;
+	TimeSinceLastShot = FMath::Min(TimeSinceLastShot, FireInterval) + DeltaTime;
+
+	int32 NumShots = 0;
+	while (NumShots < MaxShots && TimeSinceLastShot >= FireInterval)
+	{
+		// Clamp here rather than up front so a shot owed right at the edge still gets its true age
+		TimeSinceLastShot = FMath::Min(TimeSinceLastShot, MaxTime) - FireInterval;
+		OutShotAges.Add(FMath::Min(TimeSinceLastShot, DeltaTime));
+		++NumShots;
+	}
+
+	return NumShots;
+}
+
+void FWeaponFireScheduler::Reset()
+{
+	TimeSinceLastShot = TNumericLimits<float>::Max();
+	bFiredOutsideAdvance = false;
+}
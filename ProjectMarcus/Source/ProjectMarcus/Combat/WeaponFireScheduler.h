@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Fixed rate fire clock that doesn't depend on the frame rate.
+ * Frame time is accumulated and every shot owed is emitted, each tagged with how long before the end of the frame it
+ * actually happened. A 0.1s weapon delivers 10 shots a second whether the game runs at 10Hz (one per frame) or 240Hz
+ * (one every ~24 frames), where a re-armed timer loses the remainder each time it fires.
+ */
+struct PROJECTMARCUS_API FWeaponFireScheduler
+{
+	// Shots emitted in a single frame, ages in seconds before the end of the frame (oldest first)
+	typedef TArray<float, TInlineAllocator<8>> FShotAges;
+
+	void SetFireInterval(float InFireInterval) { FireInterval = FMath::Max(InFireInterval, KINDA_SMALL_NUMBER); }
+	float GetFireInterval() const { return FireInterval; }
+
+	// Longest stretch of time a single Advance will catch up on, anything older is dropped (e.g. after a long hitch)
+	void SetMaxCatchUpTime(float InMaxCatchUpTime) { MaxCatchUpTime = FMath::Max(InMaxCatchUpTime, FireInterval); }
+
+	// True once a full interval has passed since the last shot
+	bool IsReady() const { return TimeSinceLastShot >= FireInterval; }
+
+	// Records a shot fired right now (outside of Advance, e.g. on trigger press). The rest of this frame doesn't count towards the next shot
+	void FireNow();
+
+	// Accumulates DeltaTime and appends the age of every shot owed (at most MaxShots) to OutShotAges. Returns the number of shots added
+	int32 Advance(float DeltaTime, int32 MaxShots, FShotAges& OutShotAges);
+
+	void Reset();
+
+private:
+	float FireInterval = 0.1f;
+	float MaxCatchUpTime = 0.5f;
+
+	// Ready to fire straight away
+	float TimeSinceLastShot = TNumericLimits<float>::Max();
+
+	// FireNow was called this frame, so the next Advance doesn't count the time before it
+	bool bFiredOutsideAdvance = false;
+};
@@ -1,23 +1,66 @@
 #include "ProjectMarcus/Enemies/Enemy.h"
+#include "ProjectMarcus/Combat/DamageQueueSubsystem.h"
+#include "ProjectMarcus/Enemies/EnemyMovementComponent.h"
+#include "ProjectMarcus/Subsystems/CombatAudioSubsystem.h"
+#include "ProjectMarcus/Subsystems/EmitterPoolSubsystem.h"
+#include "ProjectMarcus/Subsystems/SignificanceSubsystem.h"
+#include "ProjectMarcus/UI/HUDMarkerComponent.h"
 
 #include "Kismet/GameplayStatics.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "SkeletalMeshComponentBudgeted.h"
 #include "Sound/SoundCue.h"
 #include "Particles/ParticleSystemComponent.h"
-#include "Blueprint/UserWidget.h"
+#include "Engine/SkeletalMesh.h"
+#include "PhysicsEngine/PhysicsAsset.h"
+#include "PhysicsEngine/SkeletalBodySetup.h"
 
 // Sets default values
-AEnemy::AEnemy()
-	: MaxHealth(100.f)
+AEnemy::AEnemy(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer
+		.SetDefaultSubobjectClass<USkeletalMeshComponentBudgeted>(ACharacter::MeshComponentName)
+		.SetDefaultSubobjectClass<UEnemyMovementComponent>(ACharacter::CharacterMovementComponentName))
+	, MaxHealth(100.f)
+	, HitZones(nullptr)
 	, HealthBarDisplayTime(4.f)
 	, HitReactIntervalMin(0.25f)
 	, HitReactIntervalMax(2.f)
-	, HitNumberLifetime(1.5f)
 {
-	Health = MaxHealth;
+	// Hit numbers and health bars are updated by the players UHUDMarkerComponent, nothing here needs to tick
+	PrimaryActorTick.bCanEverTick = false;
 
- 	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	// Anim ticks are handed out by the animation budget allocator, distant/hidden enemies update less often and interpolate.
+	// Significance comes from the USignificanceSubsystem
+	if (USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh()))
+	{
+		BudgetedMesh->SetAutoRegisterWithBudgetAllocator(true);
+		BudgetedMesh->SetAutoCalculateSignificance(false);
+	}
 
+	// Off screen only montages (hit reacts, death) keep playing
+	GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+}
+
+void AEnemy::OnSignificanceUpdated(float Significance, ESignificanceBucket Bucket, float TickInterval)
+{
+	if (USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh()))
+		BudgetedMesh->SetComponentSignificance(Significance);
+
+	SignificanceBucket = Bucket;
+
+	// On screen enemies always move every frame, the anim budget handles their LOD. Movement is only throttled where
+	// nobody can see it stutter (dormant, off screen or occluded)
+	const bool bThrottleMovement = Bucket == ESignificanceBucket::ESB_Dormant || !GetMesh()->WasRecentlyRendered(MovementRenderedTolerance);
+	const float MovementTickInterval = bThrottleMovement ? TickInterval : 0.f;
+	UCharacterMovementComponent* Movement = GetCharacterMovement();
+	if (Movement->GetComponentTickInterval() != MovementTickInterval)
+	{
+		Movement->SetComponentTickInterval(MovementTickInterval);
+	}
+	if (UEnemyMovementComponent* EnemyMovement = Cast<UEnemyMovementComponent>(Movement))
+	{
+		EnemyMovement->SetSignificanceBucket(Bucket);
+	}
 }
 
 // Called when the game starts or when spawned
@@ -27,72 +70,129 @@ void AEnemy::BeginPlay()
 	
 	// Allow mesh to collide with bullet line traces
 	GetMesh()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Visibility, ECollisionResponse::ECR_Block);//Set to whatever channel being used for bullets
+
+	if (UDamageQueueSubsystem* DamageQueue = GetWorld()->GetSubsystem<UDamageQueueSubsystem>())
+		DamageQueue->RegisterTarget(this, MaxHealth, MaxHealth);
+
+	if (USignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<USignificanceSubsystem>())
+		SignificanceSubsystem->RegisterActor(this, AnimSignificanceDistance);
 }
 
-void AEnemy::ShowHealthBar_Implementation()
+void AEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	GetWorldTimerManager().ClearTimer(HealthBarTimer);
-	GetWorldTimerManager().SetTimer(HealthBarTimer, this, &AEnemy::HideHealthBar, HealthBarDisplayTime);
+	if (UDamageQueueSubsystem* DamageQueue = GetWorld()->GetSubsystem<UDamageQueueSubsystem>())
+		DamageQueue->UnregisterTarget(this);
+
+	if (USignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<USignificanceSubsystem>())
+		SignificanceSubsystem->UnregisterActor(this);
+
+	Super::EndPlay(EndPlayReason);
 }
 
-void AEnemy::Die()
+void AEnemy::PostInitializeComponents()
 {
-	HideHealthBar();
+	Super::PostInitializeComponents();
+
+	ResolveHitZones();
 }
 
-void AEnemy::PlayHitMontage(FName Section, float PlayRate /*= 1.f*/)
+void AEnemy::ResolveHitZones()
 {
-	if (GetWorldTimerManager().IsTimerActive(HitReactTimer))
+	BoneHitZones.Reset();
+	BodyHitZones.Reset();
+	BodyBoneNames.Reset();
+
+	const USkeletalMeshComponent* MeshComp = GetMesh();
+	const USkeletalMesh* SkelMesh = MeshComp ? MeshComp->SkeletalMesh : nullptr;
+	if (SkelMesh == nullptr)
+	{
 		return;
+	}
 
-	const float HitReactDelay = FMath::FRandRange(HitReactIntervalMin, HitReactIntervalMax);
-	GetWorldTimerManager().SetTimer(HitReactTimer, HitReactDelay, false);
+	const FReferenceSkeleton& RefSkeleton = SkelMesh->GetRefSkeleton();
+	if (HitZones)
+	{
+		HitZones->ResolveBoneZones(RefSkeleton, BoneHitZones);
+	}
+	else
+	{
+		// No asset, the single HeadBone is all we know about
+		BoneHitZones.Init(EHitZone::EHZ_Torso, RefSkeleton.GetNum());
+		const int32 HeadIndex = RefSkeleton.FindBoneIndex(FName(*HeadBone));
+		if (HeadIndex != INDEX_NONE)
+		{
+			BoneHitZones[HeadIndex] = EHitZone::EHZ_Head;
+		}
+	}
 
-	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
-	if (AnimInstance)
+	// Bodies are created in the same order as the physics assets body setups
+	if (const UPhysicsAsset* PhysicsAsset = MeshComp->GetPhysicsAsset())
 	{
-		AnimInstance->Montage_Play(HitReactMontage, PlayRate);
-		AnimInstance->Montage_JumpToSection(Section, HitReactMontage);
+		for (const USkeletalBodySetup* BodySetup : PhysicsAsset->SkeletalBodySetups)
+		{
+			const FName BoneName = BodySetup ? BodySetup->BoneName : NAME_None;
+			const int32 BoneIndex = RefSkeleton.FindBoneIndex(BoneName);
+			BodyBoneNames.Add(BoneName);
+			BodyHitZones.Add(BoneHitZones.IsValidIndex(BoneIndex) ? BoneHitZones[BoneIndex] : EHitZone::EHZ_Torso);
+		}
 	}
 }
 
-void AEnemy::StoreHitNumber(UUserWidget* HitNumber, FVector HitLocation)
+EHitZone AEnemy::GetHitZone(const FHitResult& HitResult) const
 {
-	HitNumbers.Add(HitNumber, HitLocation);
+	// Item is the body index for a skeletal mesh hit, only trust it while it still belongs to the bone the hit reports
+	const int32 BodyIndex = HitResult.Item;
+	if (HitResult.Component.Get() == GetMesh() && BodyHitZones.IsValidIndex(BodyIndex) && BodyBoneNames[BodyIndex] == HitResult.BoneName)
+	{
+		return BodyHitZones[BodyIndex];
+	}
 
-	FTimerHandle HitNumberTimer;
-	FTimerDelegate HitNumberDelegate;
-	HitNumberDelegate.BindUFunction(this, FName("DestroyHitNumber"), HitNumber);
+	const int32 BoneIndex = GetMesh() ? GetMesh()->GetBoneIndex(HitResult.BoneName) : INDEX_NONE;
+	return BoneHitZones.IsValidIndex(BoneIndex) ? BoneHitZones[BoneIndex] : EHitZone::EHZ_Torso;
+}
 
-	GetWorld()->GetTimerManager().SetTimer(HitNumberTimer, HitNumberDelegate, HitNumberLifetime, false);
+float AEnemy::GetHitZoneDamageMultiplier(EHitZone Zone) const
+{
+	return HitZones ? HitZones->GetDamageMultiplier(Zone) : 1.f;
 }
 
-void AEnemy::DestroyHitNumber(UUserWidget* HitNumber)
+void AEnemy::ShowHealthBar_Implementation()
 {
-	HitNumbers.Remove(HitNumber);
-	HitNumber->RemoveFromParent();// Removes from viewport
+	if (UHUDMarkerComponent* HUDMarkers = UHUDMarkerComponent::Get(this))
+		HUDMarkers->ShowHealthBar(this, GetHealth() / MaxHealth, HealthBarDisplayTime);
 }
 
-void AEnemy::UpdateHitNumbers()
+void AEnemy::HideHealthBar_Implementation()
 {
-	for (TPair<UUserWidget*, FVector>& HitNumberPair : HitNumbers)
-	{
-		UUserWidget* HitNumber = HitNumberPair.Key;
-		const FVector HitLocation = HitNumberPair.Value;
-		
-		FVector2D OutScreenPosition;
-		UGameplayStatics::ProjectWorldToScreen(GetWorld()->GetFirstPlayerController(), HitLocation, OutScreenPosition);
+	if (UHUDMarkerComponent* HUDMarkers = UHUDMarkerComponent::Get(this))
+		HUDMarkers->HideHealthBar(this);
+}
 
-		HitNumber->SetPositionInViewport(OutScreenPosition);
-	}
+void AEnemy::Die()
+{
+	HideHealthBar();
 }
 
-// Called every frame
-void AEnemy::Tick(float DeltaTime)
+void AEnemy::PlayHitMontage(FName Section, float PlayRate /*= 1.f*/)
 {
-	Super::Tick(DeltaTime);
+	if (GetWorldTimerManager().IsTimerActive(HitReactTimer))
+		return;
+
+	const float HitReactDelay = FMath::FRandRange(HitReactIntervalMin, HitReactIntervalMax);
+	GetWorldTimerManager().SetTimer(HitReactTimer, HitReactDelay, false);
+
+	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
+	if (AnimInstance)
+	{
+		AnimInstance->Montage_Play(HitReactMontage, PlayRate);
+		AnimInstance->Montage_JumpToSection(Section, HitReactMontage);
+	}
+}
 
-	UpdateHitNumbers();
+void AEnemy::ShowHitNumber_Implementation(int32 Damage, FVector HitLocation, bool bHeadshot)
+{
+	if (UHUDMarkerComponent* HUDMarkers = UHUDMarkerComponent::Get(this))
+		HUDMarkers->AddHitNumber(this, Damage, HitLocation, bHeadshot);
 }
 
 // Called to bind functionality to input
@@ -104,24 +204,39 @@ void AEnemy::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 
 float AEnemy::TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
 {
-	Health = FMath::Clamp(Health - Damage, 0.f, MaxHealth);
+	if (UDamageQueueSubsystem* DamageQueue = GetWorld()->GetSubsystem<UDamageQueueSubsystem>())
+		DamageQueue->QueueDamage(this, Damage, GetActorLocation(), false, EventInstigator, DamageCauser);
 
-	if (Health <= 0.f)
+	return Damage;
+}
+
+void AEnemy::OnDamageResolved(const FResolvedDamage& Damage)
+{
+	// Everything that hit us this frame as one number
+	ShowHitNumber(FMath::RoundToInt(Damage.TotalDamage), Damage.HitLocation, Damage.bHeadshot);
+
+	if (Damage.bKilled)
 		Die();
+	else
+		ShowHealthBar();
+}
 
-	return Damage;
+float AEnemy::GetHealth() const
+{
+	const UDamageQueueSubsystem* DamageQueue = GetWorld() ? GetWorld()->GetSubsystem<UDamageQueueSubsystem>() : nullptr;
+	return DamageQueue ? DamageQueue->GetHealth(this) : 0.f;
 }
 
 void AEnemy::OnBulletHit_Implementation(const FHitResult& HitResult)
 {
-	if (ImpactSound)
-		UGameplayStatics::PlaySoundAtLocation(this, ImpactSound, GetActorLocation());
+	UCombatAudioSubsystem* CombatAudio = GetWorld()->GetSubsystem<UCombatAudioSubsystem>();
+	if (ImpactSound && CombatAudio)
+		CombatAudio->PlaySoundAtLocation(ImpactSound, GetActorLocation(), ECombatSoundCategory::ECSC_Impact);
 
-	if (ImpactParticles)
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ImpactParticles, HitResult.Location, FRotator(0.f), true);
+	UEmitterPoolSubsystem* EmitterPool = GetWorld()->GetSubsystem<UEmitterPoolSubsystem>();
+	if (ImpactParticles && EmitterPool)
+		EmitterPool->SpawnEmitter(ImpactParticles, HitResult.Location);
 
 	PlayHitMontage(FName("HitReact_Front"));//TODO: Let's not use string literals
-
-	ShowHealthBar();
 }
 
@@ -5,39 +5,43 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "ProjectMarcus/Interfaces/BulletHitInterface.h"
+#include "ProjectMarcus/Interfaces/DamageableInterface.h"
+#include "ProjectMarcus/Interfaces/SignificanceInterface.h"
+#include "ProjectMarcus/Enemies/HitZoneAsset.h"
 #include "Enemy.generated.h"
 
 UCLASS()
-class PROJECTMARCUS_API AEnemy : public ACharacter, public IBulletHitInterface
+class PROJECTMARCUS_API AEnemy : public ACharacter, public IBulletHitInterface, public IDamageableInterface, public ISignificanceInterface
 {
 	GENERATED_BODY()
 
 public:
-	// Sets default values for this character's properties
-	AEnemy();
+	// Sets default values for this character's properties. The mesh is a USkeletalMeshComponentBudgeted and movement a UEnemyMovementComponent
+	AEnemy(const FObjectInitializer& ObjectInitializer);
+
+	// Feeds the score to the animation budget allocator and slows down movement ticks while the enemy can't be seen
+	virtual void OnSignificanceUpdated(float Significance, ESignificanceBucket Bucket, float TickInterval) override;
 
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UFUNCTION(BlueprintNativeEvent)
 	void ShowHealthBar();
 	void ShowHealthBar_Implementation();
 
-	UFUNCTION(BlueprintImplementableEvent)
+	UFUNCTION(BlueprintNativeEvent)
 	void HideHealthBar();
+	void HideHealthBar_Implementation();
 
 	void Die();
 
 	void PlayHitMontage(FName Section, float PlayRate = 1.f);
 
-	UFUNCTION(BlueprintCallable)
-	void StoreHitNumber(UUserWidget* HitNumber, FVector HitLocation);
-
-	UFUNCTION()
-	void DestroyHitNumber(UUserWidget* HitNumber);
-
-	void UpdateHitNumbers();
+	// Builds the bone/body -> hit zone tables for the current mesh
+	void ResolveHitZones();
 
 private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta= (AllowPrivateAccess = true))
@@ -45,18 +49,25 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta= (AllowPrivateAccess = true))
 	class USoundCue* ImpactSound;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = true))
-	float Health;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
 	float MaxHealth;
 
+	// Only used when there's no HitZones asset, marks this one bone as the head
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
 	FString HeadBone;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
+	UHitZoneAsset* HitZones;
+
+	// Hit zone per bone index and per physics body index (FHitResult::Item) of the mesh
+	TArray<EHitZone> BoneHitZones;
+	TArray<EHitZone> BodyHitZones;
+
+	// Bone each physics body belongs to, to check a hits body index against its bone name
+	TArray<FName> BodyBoneNames;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
 	float HealthBarDisplayTime;
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = true))
-	FTimerHandle HealthBarTimer;
 
 	// Contains hit and death animations
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
@@ -70,25 +81,41 @@ private:
 
 	FTimerHandle HitReactTimer;
 
-	UPROPERTY(VisibleAnywhere, Category = Combat, meta = (AllowPrivateAccess = true))
-	TMap<UUserWidget*, FVector> HitNumbers;
+	// Distance from the camera at which significance (anim budget, movement tick rate) reaches zero
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Animation Budget", meta = (AllowPrivateAccess = true))
+	float AnimSignificanceDistance = 5000.f;
 
-	UPROPERTY(EditAnywhere, Category = Combat, meta = (AllowPrivateAccess = true))
-	float HitNumberLifetime;
+	// Seconds since the mesh was last rendered for movement to still run every frame
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Animation Budget", meta = (AllowPrivateAccess = true, ClampMin = "0"))
+	float MovementRenderedTolerance = 0.2f;
 
-public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	// Bucket from the USignificanceSubsystem
+	ESignificanceBucket SignificanceBucket = ESignificanceBucket::ESB_High;
 
+public:	
 	// Called to bind functionality to input
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
 	virtual void OnBulletHit_Implementation(const FHitResult& HitResult) override;
 
+	// Queues the damage with the UDamageQueueSubsystem, it lands in OnDamageResolved later this frame
 	virtual float TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser) override;
 
-	FORCEINLINE const FString& GetHeadBone() const { return HeadBone; }
+	virtual void OnDamageResolved(const FResolvedDamage& Damage) override;
+
+	// Health lives in the UDamageQueueSubsystem
+	UFUNCTION(BlueprintPure, Category = Combat)
+	float GetHealth() const;
 
-	UFUNCTION(BlueprintImplementableEvent)
+	virtual void PostInitializeComponents() override;
+
+	// Zone a hit on this enemy landed in, looked up by body/bone index
+	EHitZone GetHitZone(const FHitResult& HitResult) const;
+
+	float GetHitZoneDamageMultiplier(EHitZone Zone) const;
+
+	// Hit numbers and the health bar are drawn by the local players UHUDMarkerComponent
+	UFUNCTION(BlueprintNativeEvent)
 	void ShowHitNumber(int32 Damage, FVector HitLocation, bool bHeadshot = false);
+	void ShowHitNumber_Implementation(int32 Damage, FVector HitLocation, bool bHeadshot);
 };
@@ -0,0 +1,11 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Enemies/EnemyMovementComponent.h"
+#include "ProjectMarcus/Subsystems/SignificanceSubsystem.h"
+
+void UEnemyMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	FScopeCycleCounter BucketCycleCounter(USignificanceSubsystem::GetBucketTickStatId(SignificanceBucket));
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
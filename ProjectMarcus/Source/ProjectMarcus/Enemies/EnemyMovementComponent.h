@@ -0,0 +1,23 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "ProjectMarcus/Interfaces/SignificanceInterface.h"
+#include "EnemyMovementComponent.generated.h"
+
+// Enemy character movement. Its tick is the one significance throttles, so it's booked under the owners bucket stat
+UCLASS()
+class PROJECTMARCUS_API UEnemyMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	void SetSignificanceBucket(ESignificanceBucket Bucket) { SignificanceBucket = Bucket; }
+
+private:
+	ESignificanceBucket SignificanceBucket = ESignificanceBucket::ESB_High;
+};
@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Enemies/HitZoneAsset.h"
+#include "ReferenceSkeleton.h"
+
+UHitZoneAsset::UHitZoneAsset()
+{
+	for (float& Multiplier : ZoneDamageMultipliers)
+	{
+		Multiplier = 1.f;
+	}
+}
+
+void UHitZoneAsset::PostLoad()
+{
+	Super::PostLoad();
+
+	for (const TPair<EHitZone, float>& Multiplier : DamageMultipliers_DEPRECATED)
+	{
+		if (Multiplier.Key < EHitZone::EHZ_Max)
+		{
+			ZoneDamageMultipliers[(int32)Multiplier.Key] = Multiplier.Value;
+		}
+	}
+	DamageMultipliers_DEPRECATED.Empty();
+}
+
+void UHitZoneAsset::ResolveBoneZones(const FReferenceSkeleton& RefSkeleton, TArray<EHitZone>& OutBoneZones) const
+{
+	const int32 NumBones = RefSkeleton.GetNum();
+	OutBoneZones.Reset(NumBones);
+	OutBoneZones.AddUninitialized(NumBones);
+
+	TBitArray<> bListed(false, NumBones);
+	for (const FHitZoneBone& Bone : Bones)
+	{
+		const int32 BoneIndex = RefSkeleton.FindBoneIndex(Bone.BoneName);
+		if (BoneIndex == INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s: bone %s isn't in the skeleton"), *GetName(), *Bone.BoneName.ToString());
+			continue;
+		}
+
+		OutBoneZones[BoneIndex] = Bone.Zone;
+		bListed[BoneIndex] = true;
+	}
+
+	// Parents always come before their children in the reference skeleton, so one pass pushes every zone down
+	for (int32 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
+	{
+		if (bListed[BoneIndex])
+		{
+			continue;
+		}
+
+		const int32 ParentIndex = RefSkeleton.GetParentIndex(BoneIndex);
+		OutBoneZones[BoneIndex] = ParentIndex == INDEX_NONE ? DefaultZone : OutBoneZones[ParentIndex];
+	}
+}
@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "HitZoneAsset.generated.h"
+
+UENUM(BlueprintType)
+enum class EHitZone : uint8
+{
+	EHZ_Torso UMETA(DisplayName = "Torso"),
+	EHZ_Limb UMETA(DisplayName = "Limb"),
+	EHZ_Head UMETA(DisplayName = "Head"),
+	EHZ_Max UMETA(DisplayName = "InvalidMax")
+};
+
+USTRUCT(BlueprintType)
+struct FHitZoneBone
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Zones")
+	FName BoneName;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Zones")
+	EHitZone Zone = EHitZone::EHZ_Torso;
+};
+
+/**
+ * Which damage zone each bone of a skeleton belongs to, and how much each zone multiplies damage by.
+ * Authored by bone name, resolved into per bone/per physics body index tables once when an enemy is created
+ * so a hit is just an index lookup.
+ */
+UCLASS(BlueprintType)
+class PROJECTMARCUS_API UHitZoneAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// Fills OutBoneZones with the zone of every bone in RefSkeleton. Bones that aren't listed take the zone of their closest listed parent
+	void ResolveBoneZones(const FReferenceSkeleton& RefSkeleton, TArray<EHitZone>& OutBoneZones) const;
+
+	UHitZoneAsset();
+
+	virtual void PostLoad() override;
+
+	float GetDamageMultiplier(EHitZone Zone) const { return ZoneDamageMultipliers[(int32)Zone]; }
+
+private:
+	// Only the root bone of each zone needs listing, e.g. "head" also covers the jaw and eyes
+	UPROPERTY(EditAnywhere, Category = "Hit Zones")
+	TArray<FHitZoneBone> Bones;
+
+	// Zone for bones with no listed parent at all
+	UPROPERTY(EditAnywhere, Category = "Hit Zones")
+	EHitZone DefaultZone = EHitZone::EHZ_Torso;
+
+	// Applied on top of the weapons damage (HeadshotDamage for the head)
+	UPROPERTY(EditAnywhere, Category = "Hit Zones", meta = (ArraySizeEnum = "EHitZone"))
+	float ZoneDamageMultipliers[(int32)EHitZone::EHZ_Max];
+
+	// Multipliers saved before they were a fixed array, moved into ZoneDamageMultipliers on load
+	UPROPERTY()
+	TMap<EHitZone, float> DamageMultipliers_DEPRECATED;
+};
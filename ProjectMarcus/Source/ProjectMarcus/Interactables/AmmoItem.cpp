@@ -1,6 +1,5 @@
 #include "ProjectMarcus/Interactables/AmmoItem.h"
 #include "Components/WidgetComponent.h"
-#include "Components/SphereComponent.h"
 
 AAmmoItem::AAmmoItem()
 {
@@ -10,12 +9,6 @@ AAmmoItem::AAmmoItem()
 
 	// Attach everything to it
 	PickupWidget->SetupAttachment(GetRootComponent());
-	ProximityTrigger->SetupAttachment(GetRootComponent());
-}
-
-void AAmmoItem::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
 }
 
 void AAmmoItem::TryAutoPickup(float Distance)
@@ -33,77 +26,20 @@ void AAmmoItem::BeginPlay()
 
 void AAmmoItem::UpdateToState(EItemState State)
 {
-	Super::UpdateToState(State);
-
-	switch (ItemState)
-	{
-	case EItemState::EIS_PickupWaiting:
-	{
-		// Set mesh visibility
-		AmmoMesh->SetVisibility(true);
-
-		// Disable mesh physics
-		AmmoMesh->SetSimulatePhysics(false);
-		AmmoMesh->SetEnableGravity(false);
-		AmmoMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		AmmoMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		break;
-	}
-	case EItemState::EIS_PickUp:
-	{
-		// Set mesh visibility
-		AmmoMesh->SetVisibility(true);
-
-		// Disable mesh physics
-		AmmoMesh->SetSimulatePhysics(false);
-		AmmoMesh->SetEnableGravity(false);
-		AmmoMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		AmmoMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		break;
-	}
-	case EItemState::EIS_PreviewInterping:
-	{
-		// nothing special
-		break;
-	}
-	case EItemState::EIS_Equipped:
-	{
-		// Set mesh visibility
-		AmmoMesh->SetVisibility(true);
-
-		// Disable mesh physics
-		AmmoMesh->SetSimulatePhysics(false);
-		AmmoMesh->SetEnableGravity(false);
-		AmmoMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		AmmoMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		break;
-	}
-	case EItemState::EIS_Drop:
+	if (State == EItemState::EIS_Drop)
 	{
-		// Removes the item mesh from any component it was attached to (character mesh)
+		// Removes the item mesh from any component it was attached to (character mesh), before falling turns physics on
 		FDetachmentTransformRules DetachmentRules(EDetachmentRule::KeepWorld, true);
 		AmmoMesh->DetachFromComponent(DetachmentRules);
-		break;
 	}
-	case EItemState::EIS_Falling:
-	{
-		// Set mesh visibility
-		AmmoMesh->SetVisibility(true);
 
-		// Enable mesh physics
-		AmmoMesh->SetSimulatePhysics(true);
-		AmmoMesh->SetEnableGravity(true);
-		AmmoMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		AmmoMesh->SetCollisionResponseToChannel(ECollisionChannel::ECC_WorldStatic, ECollisionResponse::ECR_Block);
-		AmmoMesh->SetCollisionEnabled(ECollisionEnabled::PhysicsOnly);
-		break;
-	}
-	default:
-		break;
-	}
+	Super::UpdateToState(State);
+
+	// Same profile as the base item mesh, ItemState may have moved on (drop -> falling)
+	ApplyStateProfile(AmmoMesh, GetStateProfile(ItemState));
 }
 
-void AAmmoItem::SetCustomDepth(bool bEnabled)
+void AAmmoItem::ApplyCustomDepth(bool bEnabled)
 {
 	if (AmmoMesh)
 	{
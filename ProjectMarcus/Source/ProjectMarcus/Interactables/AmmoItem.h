@@ -18,8 +18,6 @@ class PROJECTMARCUS_API AAmmoItem : public AItemBase
 public:
 	AAmmoItem();
 
-	virtual void Tick(float DeltaTime) override;
-
 	EAmmoType GetAmmoType() { return AmmoType; }
 
 	// Attempts to auto pickup based off current item state.
@@ -31,7 +29,7 @@ protected:
 
 	virtual void UpdateToState(EItemState State) override;
 
-	virtual void SetCustomDepth(bool bEnabled) override;
+	virtual void ApplyCustomDepth(bool bEnabled) override;
 
 private:
 	// Mesh for the ammo pickup
@@ -2,13 +2,25 @@
 
 #include "ProjectMarcus/Interactables/ItemBase.h"
 #include "ProjectMarcus/Character/ProjectMarcusCharacter.h"
+#include "ProjectMarcus/Interactables/ItemCurveTable.h"
+#include "ProjectMarcus/Interactables/ItemPickupPreviewSubsystem.h"
+#include "ProjectMarcus/Interactables/ItemSpatialSubsystem.h"
+#include "ProjectMarcus/Interactables/ItemVisualSubsystem.h"
+#include "ProjectMarcus/Subsystems/CombatAudioSubsystem.h"
+#include "ProjectMarcus/Subsystems/SignificanceSubsystem.h"
+#include "ProjectMarcus/ProjectMarcus.h"
 #include "Kismet/GameplayStatics.h"
 #include "Sound/SoundCue.h"
 #include "Components/WidgetComponent.h"
-#include "Components/SphereComponent.h"
 #include "Camera/CameraComponent.h"
+#include "Curves/CurveFloat.h"
 #include "Curves/CurveVector.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Visual Changes Applied"), STAT_ItemVisualChangesApplied, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Visual Changes Skipped"), STAT_ItemVisualChangesSkipped, STATGROUP_ProjectMarcus);
+DECLARE_CYCLE_STAT(TEXT("Item State Transition"), STAT_ItemStateTransition, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item State Changes Applied"), STAT_ItemStateChangesApplied, STATGROUP_ProjectMarcus);
+
 // Sets default values
 AItemBase::AItemBase()
 {
@@ -22,38 +34,46 @@ AItemBase::AItemBase()
 	PickupWidget = CreateDefaultSubobject<UWidgetComponent>(TEXT("PickupWidget"));
 	PickupWidget->SetupAttachment(GetRootComponent());
 
-	ProximityTrigger = CreateDefaultSubobject<USphereComponent>(TEXT("ProximityTrigger"));
-	ProximityTrigger->SetupAttachment(GetRootComponent());
-}
-
-void AItemBase::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-	
-	// Interp position for preview pickup
-	CheckForItemPreviewInterp(DeltaTime);
-	
-	// Get curve values from pulse curve and set dynamic material params
-	UpdatePulseCurveValues();
+	// Everything else is visible with no collision or physics. Drop stays that way until it's detached and moves on to falling
+	StateProfiles[(int32)EItemState::EIS_PickupWaiting].bProximityTrigger = true;
+	StateProfiles[(int32)EItemState::EIS_Falling].CollisionProfile = FItemStateProfile::FallingCollisionProfile;
+	StateProfiles[(int32)EItemState::EIS_Falling].bSimulatePhysics = true;
+	StateProfiles[(int32)EItemState::EIS_Pooled].bMeshVisible = false;
+	StateProfiles[(int32)EItemState::EIS_Pooled].bActorDormant = true;
 }
 
 void AItemBase::UpdateToState(EItemState State)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ItemStateTransition);
+
 	ItemState = State;
 
+	// Components first, the state specific bits below may rely on them (e.g. the pickup preview moving the mesh)
+	const FItemStateProfile& Profile = GetStateProfile(ItemState);
+	if (IsHidden() != Profile.bActorDormant)
+	{
+		SetActorHiddenInGame(Profile.bActorDormant);
+	}
+	if (GetActorEnableCollision() == Profile.bActorDormant)
+	{
+		SetActorEnableCollision(!Profile.bActorDormant);
+	}
+	ApplyStateProfile(ItemMesh, Profile);
+	if (Profile.bProximityTrigger)
+	{
+		EnableProximityTrigger();
+	}
+	else
+	{
+		DisableProximityTrigger();
+	}
+
 	switch (ItemState)
 	{
 	case EItemState::EIS_PickupWaiting:
 	{
-		// Mesh
-		SetMeshVibility(true);
-		DisableMeshPhysycs();
-		
-		// Pickup Trigger
-		EnableProximityTrigger();
-		
-		// Once we enter pickup waiting, kickoff the pulse timer
-		ResetPulseTimer();
+		// Once we enter pickup waiting, restart the pulse loop
+		PulseStartTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.f;
 
 		// Once we drop turn the glow back on
 		SetGlowMaterial(true);
@@ -67,13 +87,6 @@ void AItemBase::UpdateToState(EItemState State)
 		// Pickup SFX
 		PlayPickupSound();
 
-		// Mesh
-		SetMeshVibility(true);
-		DisableMeshPhysycs();
-		
-		// Pickup Trigger
-		DisableProximityTrigger();
-
 		// HUD
 		// Only disable pickup widget, keep the glow/colour materials until we equip it
 		SetPickupWidgetVisibility(false);
@@ -93,13 +106,6 @@ void AItemBase::UpdateToState(EItemState State)
 		// TODO: If we want to play a sound on pickup but no equip put that here
 		//PlayEquipSound();
 
-		// Mesh
-		SetMeshVibility(true);
-		DisableMeshPhysycs();
-
-		// Pickup Trigger
-		DisableProximityTrigger();
-
 		// HUD & VFX
 		// fully disable all visuals (pickup widget, glow and outline materials)
 		SetPickupItemVisuals(false);
@@ -114,13 +120,6 @@ void AItemBase::UpdateToState(EItemState State)
 		// Equip SFX
 		PlayEquipSound();
 
-		// Mesh
-		SetMeshVibility(true);
-		DisableMeshPhysycs();
-		
-		// Pickup Trigger
-		DisableProximityTrigger();
-
 		// HUD & VFX
 		// fully disable all visuals (pickup widget, glow and outline materials)
 		SetPickupItemVisuals(false);
@@ -141,20 +140,120 @@ void AItemBase::UpdateToState(EItemState State)
 	}
 	case EItemState::EIS_Falling:
 	{
-		// Mesh
-		SetMeshVibility(true);
-		EnableMeshPhysics();
-
-		// Pickup Trigger
-		DisableProximityTrigger();
-
 		// HUD & VFX
 		SetPickupItemVisuals(false);
 		break;
 	}
+	case EItemState::EIS_Pooled:
+	{
+		// HUD & VFX
+		SetPickupItemVisuals(false);
+		SetGlowMaterial(false);
+		break;
+	}
 	default:
 		break;
 	}
+
+	UpdatePulseRegistration();
+
+	// The state is part of the score, don't wait for this items turn in the rescore
+	if (USignificanceSubsystem* Significance = GetWorld() ? GetWorld()->GetSubsystem<USignificanceSubsystem>() : nullptr)
+	{
+		Significance->RescoreActor(this);
+	}
+
+	UpdateTickEnabled();
+}
+
+float AItemBase::GetSignificanceStateScale() const
+{
+	switch (ItemState)
+	{
+	case EItemState::EIS_PickUp:
+	case EItemState::EIS_PickedUpNoEquip:
+	case EItemState::EIS_Pooled:
+		return 0.f;
+	default:
+		return 1.f;
+	}
+}
+
+bool AItemBase::IsAlwaysSignificant() const
+{
+	return ItemState == EItemState::EIS_Equipped;
+}
+
+void AItemBase::OnSignificanceUpdated(float Significance, ESignificanceBucket Bucket, float TickInterval)
+{
+	if (Bucket != SignificanceBucket)
+	{
+		SignificanceBucket = Bucket;
+		SetActorTickInterval(TickInterval);
+		UpdateTickEnabled();
+	}
+}
+
+void AItemBase::TickActor(float DeltaTime, ELevelTick TickType, FActorTickFunction& ThisTickFunction)
+{
+	FScopeCycleCounter BucketCycleCounter(USignificanceSubsystem::GetBucketTickStatId(SignificanceBucket));
+
+	Super::TickActor(DeltaTime, TickType, ThisTickFunction);
+}
+
+void AItemBase::UpdateTickEnabled()
+{
+	// Only tick when something per frame is actually happening
+	SetActorTickEnabled(ShouldTickInState(ItemState) && SignificanceBucket != ESignificanceBucket::ESB_Dormant);
+}
+
+void AItemBase::ResetForReuse()
+{
+	if (GetWorld())
+	{
+		GetWorldTimerManager().ClearTimer(ItemInterpHandle);
+		GetWorldTimerManager().ClearTimer(KnockbackTimer);
+		if (UItemPickupPreviewSubsystem* PreviewSubsystem = GetWorld()->GetSubsystem<UItemPickupPreviewSubsystem>())
+		{
+			PreviewSubsystem->RemovePreview(this);
+		}
+	}
+
+	// Detach from whatever was holding us (character mesh)
+	DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+
+	bPreviewInterping = false;
+	CachedCharInPickupRange = nullptr;
+	PickupLocationIdx = 0;
+	InventorySlotIndex = -1;
+	bSwapInsteadOfPickup = false;
+	SetActorScale3D(FVector(1.f));
+}
+
+void AItemBase::ApplyKnockback(const FVector& Origin, float Radius, float Strength)
+{
+	// Anything held, previewing or already falling isn't lying around to be blown away.
+	// The root is what simulates while falling (ItemMesh here, AmmoMesh for ammo)
+	UPrimitiveComponent* RootPrimitive = Cast<UPrimitiveComponent>(GetRootComponent());
+	if (ItemState != EItemState::EIS_PickupWaiting || RootPrimitive == nullptr)
+	{
+		return;
+	}
+
+	// Falling takes us out of the pickup index and turns physics on
+	UpdateToState(EItemState::EIS_Falling);
+	RootPrimitive->AddRadialImpulse(Origin, Radius, Strength, ERadialImpulseFalloff::RIF_Linear, true);
+
+	GetWorldTimerManager().SetTimer(KnockbackTimer, this, &AItemBase::FinishKnockback, KnockbackSettleTime);
+}
+
+void AItemBase::FinishKnockback()
+{
+	// Back into the index at wherever we ended up
+	if (ItemState == EItemState::EIS_Falling)
+	{
+		UpdateToState(EItemState::EIS_PickupWaiting);
+	}
 }
 
 void AItemBase::SetPickupItemVisuals(bool bIsVisible)
@@ -165,11 +264,43 @@ void AItemBase::SetPickupItemVisuals(bool bIsVisible)
 	SetPickupWidgetVisibility(bIsVisible);
 }
 
+void AItemBase::FlushVisualState()
+{
+	bVisualFlushQueued = false;
+
+	const EItemVisualFlags ChangedFlags = bVisualStateApplied ? (DesiredVisualState ^ AppliedVisualState) : EItemVisualFlags::All;
+	if (EnumHasAnyFlags(ChangedFlags, EItemVisualFlags::CustomDepth))
+	{
+		ApplyCustomDepth(EnumHasAnyFlags(DesiredVisualState, EItemVisualFlags::CustomDepth));
+		INC_DWORD_STAT(STAT_ItemVisualChangesApplied);
+	}
+	if (EnumHasAnyFlags(ChangedFlags, EItemVisualFlags::Glow))
+	{
+		ApplyGlowMaterial(EnumHasAnyFlags(DesiredVisualState, EItemVisualFlags::Glow));
+		INC_DWORD_STAT(STAT_ItemVisualChangesApplied);
+	}
+	if (EnumHasAnyFlags(ChangedFlags, EItemVisualFlags::PickupWidget))
+	{
+		ApplyPickupWidgetVisibility(EnumHasAnyFlags(DesiredVisualState, EItemVisualFlags::PickupWidget));
+		INC_DWORD_STAT(STAT_ItemVisualChangesApplied);
+	}
+
+	AppliedVisualState = DesiredVisualState;
+	bVisualStateApplied = true;
+}
+
 // Called when the game starts or when spawned
 void AItemBase::BeginPlay()
 {
 	Super::BeginPlay();
 
+	if (USignificanceSubsystem* Significance = GetWorld()->GetSubsystem<USignificanceSubsystem>())
+	{
+		Significance->RegisterActor(this);
+	}
+
+	CurveTable = GetClassCurveTable();
+
 	// Hide by default
 	SetPickupItemVisuals(false);
 
@@ -184,6 +315,29 @@ void AItemBase::BeginPlay()
 	}
 }
 
+void AItemBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	DisableProximityTrigger();
+
+	if (UWorld* World = GetWorld())
+	{
+		if (UItemVisualSubsystem* VisualSubsystem = World->GetSubsystem<UItemVisualSubsystem>())
+		{
+			VisualSubsystem->UnregisterPulse(this);
+		}
+		if (USignificanceSubsystem* Significance = World->GetSubsystem<USignificanceSubsystem>())
+		{
+			Significance->UnregisterActor(this);
+		}
+		if (UItemPickupPreviewSubsystem* PreviewSubsystem = World->GetSubsystem<UItemPickupPreviewSubsystem>())
+		{
+			PreviewSubsystem->RemovePreview(this);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AItemBase::OnConstruction(const FTransform& Transform)
 {
 	Super::OnConstruction(Transform);
@@ -204,12 +358,56 @@ void AItemBase::OnConstruction(const FTransform& Transform)
 	SetGlowMaterial(true);
 }
 
+void AItemBase::PostLoad()
+{
+	Super::PostLoad();
+
+	// Blueprint class defaults bake while loading rather than on the first item's BeginPlay
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		GetClassCurveTable();
+	}
+}
+
+#if WITH_EDITOR
+void AItemBase::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Swapping a curve on the class defaults re-bakes the shared table, edits to the curves themselves are picked up by the table
+	const FName PropertyName = PropertyChangedEvent.GetPropertyName();
+	const bool bCurveChanged = PropertyName == GET_MEMBER_NAME_CHECKED(AItemBase, ItemZPickupPreviewCurve)
+		|| PropertyName == GET_MEMBER_NAME_CHECKED(AItemBase, ItemScaleCurve)
+		|| PropertyName == GET_MEMBER_NAME_CHECKED(AItemBase, PulseCurve)
+		|| PropertyName == GET_MEMBER_NAME_CHECKED(AItemBase, InterpPulseCurve);
+	if (bCurveChanged && HasAnyFlags(RF_ClassDefaultObject) && CurveTable)
+	{
+		CurveTable->Bake(ItemZPickupPreviewCurve, ItemScaleCurve, PulseCurve, InterpPulseCurve);
+	}
+}
+#endif
+
 void AItemBase::InitCustomDepth()
 {
 	SetCustomDepth(false);
 }
 
 void AItemBase::SetCustomDepth(bool bEnabled)
+{
+	SetDesiredVisualFlag(EItemVisualFlags::CustomDepth, bEnabled);
+}
+
+void AItemBase::SetGlowMaterial(bool bEnabled)
+{
+	SetDesiredVisualFlag(EItemVisualFlags::Glow, bEnabled);
+}
+
+void AItemBase::SetPickupWidgetVisibility(bool bVisible)
+{
+	SetDesiredVisualFlag(EItemVisualFlags::PickupWidget, bVisible);
+}
+
+void AItemBase::ApplyCustomDepth(bool bEnabled)
 {
 	if (ItemMesh)
 	{
@@ -217,156 +415,162 @@ void AItemBase::SetCustomDepth(bool bEnabled)
 	}
 }
 
-void AItemBase::SetGlowMaterial(bool bEnabled)
+void AItemBase::ApplyGlowMaterial(bool bEnabled)
 {
 	if (DynamicMaterialInstance)
 	{
-		
 		DynamicMaterialInstance->SetScalarParameterValue(TEXT("GlowBlendAlpha"), (int)bEnabled);
 	}
 }
 
-void AItemBase::SetPickupWidgetVisibility(bool bVisible)
+void AItemBase::ApplyPickupWidgetVisibility(bool bVisible)
 {
 	PickupWidget->SetVisibility(bVisible);
 }
 
-// TODO: Technically if the character spawns within the overlap region this "on begin" doesn't trigger since they didn't _enter_ the overlap.
-// Might want to check something like once a second if something is inside us. Maybe not. Something to consider. Maybe this is only possible in the editor
-void AItemBase::OnBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void AItemBase::SetDesiredVisualFlag(EItemVisualFlags Flag, bool bEnabled)
 {
-	// tell the actor that just started overlapping that we are within range
-	if (OtherActor)
+	if (bEnabled)
 	{
-		// check if the actor overlapping is our character
-		AProjectMarcusCharacter* PMCharacter = Cast<AProjectMarcusCharacter>(OtherActor);
-		if (PMCharacter)
-		{
-			PMCharacter->AddItemInRange(this);
-			CachedCharInPickupRange = PMCharacter;
-		}
+		DesiredVisualState |= Flag;
+	}
+	else
+	{
+		DesiredVisualState &= ~Flag;
 	}
-}
 
-void AItemBase::OnEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
-{
-	// tell the actor that just ended overlapping we are no longer in range
-	if (OtherActor)
+	if (bVisualStateApplied && DesiredVisualState == AppliedVisualState)
 	{
-		// check if the actor overlapping is our character
-		AProjectMarcusCharacter* PMCharacter = Cast<AProjectMarcusCharacter>(OtherActor);
-		if (PMCharacter)
-		{
-			PMCharacter->RemoveItemInRange(this);
-			CachedCharInPickupRange = nullptr;
-		}
+		// Previously this would have dirtied render state for nothing
+		INC_DWORD_STAT(STAT_ItemVisualChangesSkipped);
+		return;
 	}
-}
 
-void AItemBase::CheckForItemPreviewInterp(float DeltaTime)
-{
-	if (bPreviewInterping)
+	if (!bVisualFlushQueued)
 	{
-		if (CachedCharInPickupRange)
+		UItemVisualSubsystem* VisualSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UItemVisualSubsystem>() : nullptr;
+		if (VisualSubsystem && GetWorld()->IsGameWorld())
 		{
-			if (ItemZPickupPreviewCurve)
-			{
-				const float ElapsedTime = GetWorldTimerManager().GetTimerElapsed(ItemInterpHandle);
-
-				/* Calculate Location */
-
-				const float ZPositionCurveValue = ItemZPickupPreviewCurve->GetFloatValue(ElapsedTime);
-
-				// Determine base Z height for when Curve is at 1.0
-				FVector CameraInterpLocation;
-				GetPickupInterpLocation(CameraInterpLocation); //CachedCharInPickupRange->GetCameraInterpLocation(); // Get location in front of the camera
-
-				const FVector DistFromItemToCameraUp = FVector(0.f, 0.f, (CameraInterpLocation - ItemPickupPreviewStartLocation).Z); // Distance vertically between item's starting position and the camera
-				const float BaseZHeight = DistFromItemToCameraUp.Size(); // Get a scalar for the desired Z height
-
-				// CurveValue = 1.0 ItemLocationThisFrame will be exactly at DistFromItemToCameraUp. 
-				// CurveValue > 1.0 ItemLocationThisFrame will be higher than DistFromItemToCameraUp
-				// CurveValue < 1.0 ItemLocationThisFrame will be lower than DistFromItemToCameraUp
-				const float ZHeightThisFrame = ItemPickupPreviewStartLocation.Z + (ZPositionCurveValue * BaseZHeight);
-
-				const FVector ItemCurrentLocation = GetActorLocation();
-				// Val = A + (B-A) * (t * speed)
-				const float InterpXValue = FMath::FInterpTo(ItemCurrentLocation.X, CameraInterpLocation.X, DeltaTime, 30.f);
-				const float InterpYValue = FMath::FInterpTo(ItemCurrentLocation.Y, CameraInterpLocation.Y, DeltaTime, 30.f);
-
-				// New location based off curve and X/Y interpolation
-				FVector ItemLocationThisFrame = FVector(InterpXValue, InterpYValue, ZHeightThisFrame);
-				SetActorLocation(ItemLocationThisFrame, true, nullptr, ETeleportType::TeleportPhysics);
-
-				/* Calculate Rotation */
-
-				UCameraComponent* CharCamComp = CachedCharInPickupRange->GetFollowCamera();
-				if (CharCamComp)
-				{
-					// Pickup Visual v1
-					// Item is rotated to match the cameras rotation but keeps all item rotations in tact. Player sees item in rotation matching when it was picked up, but always in front of the camera.
-					//const FRotator ItemOffsetCameraYaw = FRotator(0.f, CharCamComp->GetComponentRotation().Yaw + YawDiffBetweenCameraAndItem,0.f);
-					//SetActorRotation(ItemOffsetCameraYaw, ETeleportType::TeleportPhysics);
-
-					// Pickup Visual v2
-					// Item matches camera Yaw only. Player sees side face of the item matching camera Yaw rotation, but with original Pitch and Roll.
-					//const FRotator ItemMatchCameraYaw = FRotator(0.f, CharCamComp->GetComponentRotation().Yaw, 0.f);
-					//SetActorRotation(ItemMatchCameraYaw, ETeleportType::TeleportPhysics);
-
-					// Pickup Visual v3 (current)
-					// Item matches camera rotation exactly. Player sees the side face of the item matching camera rotation
-					SetActorRotation(CharCamComp->GetComponentRotation(), ETeleportType::TeleportPhysics);
-				}
-
-				/* Calculate Scale */
-				if (ItemScaleCurve)
-				{
-					// CurveValue = 1.0 most of the curve till it decreases sharply at the end (shrinking at the end)
-					const float ScaleCurveValue = ItemScaleCurve->GetFloatValue(ElapsedTime);
-					SetActorScale3D(FVector(ScaleCurveValue, ScaleCurveValue, ScaleCurveValue));
-				}
-			}
-			else
-			{
-				UE_LOG(LogTemp, Error, TEXT("ItemZPickupPreviewCurve is invalid!"));
-			}
+			VisualSubsystem->QueueVisualFlush(this);
+			bVisualFlushQueued = true;
 		}
 		else
 		{
-			UE_LOG(LogTemp, Error, TEXT("CachedCharInPickupRange is invalid!"));
+			// No end of frame flush outside of game worlds (editor construction), apply right away
+			FlushVisualState();
 		}
 	}
 }
 
-void AItemBase::GetPickupInterpLocation(FVector& OutInterpLocation)
+bool AItemBase::ComputePickupPreviewTransform(const FVector& TargetLocation, const FRotator& CameraRotation, float DeltaTime, FTransform& OutTransform) const
 {
-	OutInterpLocation = FVector::ZeroVector;
+	if (!HasPickupPreviewZCurve())
+	{
+		UE_LOG(LogTemp, Error, TEXT("ItemZPickupPreviewCurve is invalid!"));
+		return false;
+	}
 
-	if (CachedCharInPickupRange)
+	const float ElapsedTime = GetWorldTimerManager().GetTimerElapsed(ItemInterpHandle);
+
+	/* Calculate Location */
+
+	const float ZPositionCurveValue = EvaluatePickupPreviewZ(ElapsedTime);
+
+	// Determine base Z height for when Curve is at 1.0
+	const FVector DistFromItemToCameraUp = FVector(0.f, 0.f, (TargetLocation - ItemPickupPreviewStartLocation).Z); // Distance vertically between item's starting position and the camera
+	const float BaseZHeight = DistFromItemToCameraUp.Size(); // Get a scalar for the desired Z height
+
+	// CurveValue = 1.0 ItemLocationThisFrame will be exactly at DistFromItemToCameraUp. 
+	// CurveValue > 1.0 ItemLocationThisFrame will be higher than DistFromItemToCameraUp
+	// CurveValue < 1.0 ItemLocationThisFrame will be lower than DistFromItemToCameraUp
+	const float ZHeightThisFrame = ItemPickupPreviewStartLocation.Z + (ZPositionCurveValue * BaseZHeight);
+
+	const FVector ItemCurrentLocation = GetActorLocation();
+	// Val = A + (B-A) * (t * speed)
+	const float InterpXValue = FMath::FInterpTo(ItemCurrentLocation.X, TargetLocation.X, DeltaTime, 30.f);
+	const float InterpYValue = FMath::FInterpTo(ItemCurrentLocation.Y, TargetLocation.Y, DeltaTime, 30.f);
+
+	// New location based off curve and X/Y interpolation
+	OutTransform.SetLocation(FVector(InterpXValue, InterpYValue, ZHeightThisFrame));
+
+	/* Calculate Rotation */
+
+	// Pickup Visual v1
+	// Item is rotated to match the cameras rotation but keeps all item rotations in tact. Player sees item in rotation matching when it was picked up, but always in front of the camera.
+	//const FRotator ItemOffsetCameraYaw = FRotator(0.f, CameraRotation.Yaw + YawDiffBetweenCameraAndItem,0.f);
+
+	// Pickup Visual v2
+	// Item matches camera Yaw only. Player sees side face of the item matching camera Yaw rotation, but with original Pitch and Roll.
+	//const FRotator ItemMatchCameraYaw = FRotator(0.f, CameraRotation.Yaw, 0.f);
+
+	// Pickup Visual v3 (current)
+	// Item matches camera rotation exactly. Player sees the side face of the item matching camera rotation
+	OutTransform.SetRotation(CameraRotation.Quaternion());
+
+	/* Calculate Scale */
+
+	if (ItemScaleCurve)
 	{
-		switch (ItemType)
-		{
-			case EItemType::EIT_Ammo:
-			{
-				CachedCharInPickupRange->GetPickupLocationLocation(PickupLocationIdx, OutInterpLocation);
-				break;
-			}
-			case EItemType::EIT_Weapon:
-			{
-				CachedCharInPickupRange->GetPickupLocationLocation(0, OutInterpLocation); // the 0th index is always our weapon index
-				break;
-			}
-			default:
-				UE_LOG(LogTemp, Error, TEXT("AItemBase::GetPickupInterpLocation, EItemType not set!"));
-			break;
-		}
+		// CurveValue = 1.0 most of the curve till it decreases sharply at the end (shrinking at the end)
+		const float ScaleCurveValue = EvaluatePickupScale(ElapsedTime);
+		OutTransform.SetScale3D(FVector(ScaleCurveValue));
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("CachedCharacter is invalid!"));
+		OutTransform.SetScale3D(GetActorScale3D());
+	}
+
+	return true;
+}
+
+int32 AItemBase::GetPickupPreviewLocationIndex() const
+{
+	switch (ItemType)
+	{
+		case EItemType::EIT_Ammo:
+			return PickupLocationIdx;
+		case EItemType::EIT_Weapon:
+			return 0; // the 0th index is always our weapon index
+		default:
+			UE_LOG(LogTemp, Error, TEXT("AItemBase::GetPickupPreviewLocationIndex, EItemType not set!"));
+			return INDEX_NONE;
 	}
 }
 
+UItemCurveTable* AItemBase::GetClassCurveTable() const
+{
+	AItemBase* ClassDefaults = GetClass()->GetDefaultObject<AItemBase>();
+	if (ClassDefaults->CurveTable == nullptr)
+	{
+		ClassDefaults->CurveTable = NewObject<UItemCurveTable>(ClassDefaults);
+		ClassDefaults->CurveTable->Bake(ClassDefaults->ItemZPickupPreviewCurve, ClassDefaults->ItemScaleCurve, ClassDefaults->PulseCurve, ClassDefaults->InterpPulseCurve);
+	}
+	return ClassDefaults->CurveTable;
+}
+
+bool AItemBase::HasPickupPreviewZCurve() const
+{
+	return ItemZPickupPreviewCurve != nullptr;
+}
+
+float AItemBase::EvaluatePickupPreviewZ(float Time) const
+{
+	if (CurveTable && CurveTable->HasPickupPreviewZ())
+	{
+		return CurveTable->EvaluatePickupPreviewZ(Time);
+	}
+	return ItemZPickupPreviewCurve ? ItemZPickupPreviewCurve->GetFloatValue(Time) : 0.f;
+}
+
+float AItemBase::EvaluatePickupScale(float Time) const
+{
+	if (CurveTable && CurveTable->HasScale())
+	{
+		return CurveTable->EvaluateScale(Time);
+	}
+	return ItemScaleCurve ? ItemScaleCurve->GetFloatValue(Time) : 1.f;
+}
+
 void AItemBase::StartPickupPreview()
 {
 	ItemPickupPreviewStartLocation = GetActorLocation();
@@ -374,8 +578,10 @@ void AItemBase::StartPickupPreview()
 	{
 		GetWorld()->GetTimerManager().SetTimer(ItemInterpHandle, this, &AItemBase::FinishPickupPreview, ItemPickupPreviewDuration);
 
-		// No need to run the pulse timer if we're picked up
-		GetWorld()->GetTimerManager().ClearTimer(PulseTimer);
+		if (UItemPickupPreviewSubsystem* PreviewSubsystem = GetWorld()->GetSubsystem<UItemPickupPreviewSubsystem>())
+		{
+			PreviewSubsystem->AddPreview(this);
+		}
 	}
 
 	// Store the angle between camera and item (so we know what constant angle offset to keep the item at relative to the camera if the player rotates during pickup)
@@ -400,6 +606,10 @@ void AItemBase::StartPickupPreview()
 void AItemBase::FinishPickupPreview()
 {
 	bPreviewInterping = false;
+	if (UItemPickupPreviewSubsystem* PreviewSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UItemPickupPreviewSubsystem>() : nullptr)
+	{
+		PreviewSubsystem->RemovePreview(this);
+	}
 	// reset scale of mesh since we shrunk it during preview
 	SetActorScale3D(FVector(1.f));
 	if (CachedCharInPickupRange)
@@ -407,7 +617,7 @@ void AItemBase::FinishPickupPreview()
 		// Tell the character we're not longer interping to pickup location
 		CachedCharInPickupRange->RemoveItemFromPickupLocation(PickupLocationIdx);
 
-		// Once we pick it up we turn off overlaps, so the organic "OnEndOverlap" which removes this item from range will not fire. Need to fire it manually on pickup
+		// Once we pick it up we leave the pickup index, so the characters range check will never see it again. Need to hand it over manually on pickup
 		CachedCharInPickupRange->PickupItemAfterPreview(this);
 	}
 
@@ -419,67 +629,87 @@ void AItemBase::FinishPickupPreview()
 
 void AItemBase::EnableProximityTrigger()
 {
-	if (ProximityTrigger)
+	if (bInProximityIndex)
 	{
-		if (!ProximityTrigger->OnComponentBeginOverlap.IsBound())
-		{
-			ProximityTrigger->OnComponentBeginOverlap.AddDynamic(this, &AItemBase::OnBeginOverlap);
-		}
-		if (!ProximityTrigger->OnComponentEndOverlap.IsBound())
+		return;
+	}
+
+	bInProximityIndex = true;
+	if (UWorld* World = GetWorld())
+	{
+		if (UItemSpatialSubsystem* ItemIndex = World->GetSubsystem<UItemSpatialSubsystem>())
 		{
-			ProximityTrigger->OnComponentEndOverlap.AddDynamic(this, &AItemBase::OnEndOverlap);
+			ItemIndex->RegisterItem(this);
 		}
 	}
-
-	ProximityTrigger->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Overlap);
-	ProximityTrigger->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
 }
 
 void AItemBase::DisableProximityTrigger()
 {
-	if (ProximityTrigger)
+	if (!bInProximityIndex)
 	{
-		if (ProximityTrigger->OnComponentBeginOverlap.IsBound())
-		{
-			ProximityTrigger->OnComponentBeginOverlap.RemoveDynamic(this, &AItemBase::OnBeginOverlap);
-		}
-		if (ProximityTrigger->OnComponentEndOverlap.IsBound())
+		return;
+	}
+
+	bInProximityIndex = false;
+	if (UWorld* World = GetWorld())
+	{
+		if (UItemSpatialSubsystem* ItemIndex = World->GetSubsystem<UItemSpatialSubsystem>())
 		{
-			ProximityTrigger->OnComponentEndOverlap.RemoveDynamic(this, &AItemBase::OnEndOverlap);
+			ItemIndex->UnregisterItem(this);
 		}
 	}
-
-	ProximityTrigger->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-	ProximityTrigger->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 }
 
-void AItemBase::EnableMeshPhysics()
+void AItemBase::ApplyStateProfile(UPrimitiveComponent* Component, const FItemStateProfile& Profile)
 {
-	ItemMesh->SetSimulatePhysics(true);
-	ItemMesh->SetEnableGravity(true);
-	ItemMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-	ItemMesh->SetCollisionResponseToChannel(ECollisionChannel::ECC_WorldStatic, ECollisionResponse::ECR_Block);
-	ItemMesh->SetCollisionEnabled(ECollisionEnabled::PhysicsOnly);
-}
+	if (Component == nullptr)
+	{
+		return;
+	}
 
-void AItemBase::DisableMeshPhysycs()
-{
-	ItemMesh->SetSimulatePhysics(false);
-	ItemMesh->SetEnableGravity(false);
-	ItemMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-	ItemMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-}
+	// Physics goes off before the collision it needs and on after it
+	const bool bPhysicsChanged = Component->BodyInstance.bSimulatePhysics != Profile.bSimulatePhysics;
+	if (bPhysicsChanged && !Profile.bSimulatePhysics)
+	{
+		Component->SetSimulatePhysics(false);
+		INC_DWORD_STAT(STAT_ItemStateChangesApplied);
+	}
 
-void AItemBase::SetMeshVibility(bool bVisible)
-{
-	ItemMesh->SetVisibility(bVisible);
+	// One collision update instead of one per response/enabled change
+	if (Component->GetCollisionProfileName() != Profile.CollisionProfile)
+	{
+		Component->SetCollisionProfileName(Profile.CollisionProfile);
+		INC_DWORD_STAT(STAT_ItemStateChangesApplied);
+	}
+
+	if (bPhysicsChanged && Profile.bSimulatePhysics)
+	{
+		Component->SetSimulatePhysics(true);
+		INC_DWORD_STAT(STAT_ItemStateChangesApplied);
+	}
+
+	if (Component->IsGravityEnabled() != Profile.bSimulatePhysics)
+	{
+		Component->SetEnableGravity(Profile.bSimulatePhysics);
+		INC_DWORD_STAT(STAT_ItemStateChangesApplied);
+	}
+
+	if (Component->IsVisible() != Profile.bMeshVisible)
+	{
+		Component->SetVisibility(Profile.bMeshVisible);
+		INC_DWORD_STAT(STAT_ItemStateChangesApplied);
+	}
 }
 
 void AItemBase::PlayPickupSound()
 {
 	if (PickupSound)
 	{
-		UGameplayStatics::PlaySound2D(this, PickupSound);
+		if (UCombatAudioSubsystem* CombatAudio = GetWorld() ? GetWorld()->GetSubsystem<UCombatAudioSubsystem>() : nullptr)
+		{
+			CombatAudio->PlaySound2D(PickupSound, ECombatSoundCategory::ECSC_Item, 1.5f);
+		}
 	}
 }
 
@@ -487,34 +717,64 @@ void AItemBase::PlayEquipSound()
 {
 	if (EquipSound)
 	{
-		UGameplayStatics::PlaySound2D(this, EquipSound);
+		if (UCombatAudioSubsystem* CombatAudio = GetWorld() ? GetWorld()->GetSubsystem<UCombatAudioSubsystem>() : nullptr)
+		{
+			CombatAudio->PlaySound2D(EquipSound, ECombatSoundCategory::ECSC_Item, 1.5f);
+		}
 	}
 }
 
-void AItemBase::UpdatePulseCurveValues()
+bool AItemBase::GetPulseCurveSample(bool& bOutInterpPulse, float& OutTime) const
 {
-	float ElapsedTime;
-	FVector CurveValue;
+	bOutInterpPulse = false;
+	OutTime = 0.f;
 
 	// Difference pulses based off whether its being actively picked up or not
 	switch (ItemState)
 	{
 		case EItemState::EIS_PickupWaiting:
-			if (PulseCurve)
+			if (PulseCurve && GetWorld())
 			{
-				ElapsedTime = GetWorldTimerManager().GetTimerElapsed(PulseTimer);
-				CurveValue = PulseCurve->GetVectorValue(ElapsedTime);
+				OutTime = FMath::Fmod(GetWorld()->GetTimeSeconds() - PulseStartTime, PulseCurveDuration);
+				return true;
 			}
 		break;
 		case EItemState::EIS_PreviewInterping:
 			if (InterpPulseCurve)
 			{
-				ElapsedTime = GetWorldTimerManager().GetTimerElapsed(ItemInterpHandle);
-				CurveValue = InterpPulseCurve->GetVectorValue(ElapsedTime);
+				bOutInterpPulse = true;
+				OutTime = GetWorldTimerManager().GetTimerElapsed(ItemInterpHandle);
+				return true;
 			}
 		break;
 	}
 
+	return false;
+}
+
+FVector AItemBase::EvaluatePulseCurve(bool bInterpPulse, float Time) const
+{
+	if (bInterpPulse)
+	{
+		if (CurveTable && CurveTable->HasInterpPulse())
+		{
+			return CurveTable->EvaluateInterpPulse(Time);
+		}
+		return InterpPulseCurve ? InterpPulseCurve->GetVectorValue(Time) : FVector::ZeroVector;
+	}
+
+	if (CurveTable && CurveTable->HasPulse())
+	{
+		return CurveTable->EvaluatePulse(Time);
+	}
+	return PulseCurve ? PulseCurve->GetVectorValue(Time) : FVector::ZeroVector;
+}
+
+void AItemBase::ApplyPulseCurveValues(const FVector& CurveValue)
+{
+	static const FName GlowAmountParam(TEXT("GlowAmount"));
+	static const FName FresnelExponentParam(TEXT("FresnelExponent"));
+	static const FName FresnelReflectParam(TEXT("FresnelReflectFraction"));
 
 	const float GlowAmtThisFrame = CurveValue.X;
 	const float FresnelExpThisFrame = CurveValue.Y;
@@ -522,20 +782,32 @@ void AItemBase::UpdatePulseCurveValues()
 
 	if (DynamicMaterialInstance)
 	{
-		DynamicMaterialInstance->SetScalarParameterValue(TEXT("GlowAmount"), GlowAmtThisFrame * GlowMatAlpha);
-		DynamicMaterialInstance->SetScalarParameterValue(TEXT("FresnelExponent"), FresnelExpThisFrame * FresnelExponent);
-		DynamicMaterialInstance->SetScalarParameterValue(TEXT("FresnelReflectFraction"), FresnelReflectThisFrame * FresnelReflect);
+		DynamicMaterialInstance->SetScalarParameterValue(GlowAmountParam, GlowAmtThisFrame * GlowMatAlpha);
+		DynamicMaterialInstance->SetScalarParameterValue(FresnelExponentParam, FresnelExpThisFrame * FresnelExponent);
+		DynamicMaterialInstance->SetScalarParameterValue(FresnelReflectParam, FresnelReflectThisFrame * FresnelReflect);
 	}
 }
 
-void AItemBase::ResetPulseTimer()
+void AItemBase::UpdatePulseRegistration()
 {
-	if (ItemState == EItemState::EIS_PickupWaiting)
+	UItemVisualSubsystem* VisualSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UItemVisualSubsystem>() : nullptr;
+	if (VisualSubsystem == nullptr)
 	{
-		if (GetWorld())
-		{
-			GetWorld()->GetTimerManager().SetTimer(PulseTimer, this, &AItemBase::ResetPulseTimer, PulseCurveDuration);
-		}
+		return;
+	}
+
+	if (ItemState == EItemState::EIS_PickupWaiting || ItemState == EItemState::EIS_PreviewInterping)
+	{
+		VisualSubsystem->RegisterPulse(this);
+	}
+	else
+	{
+		VisualSubsystem->UnregisterPulse(this);
 	}
 }
 
+bool AItemBase::ShouldTickInState(EItemState State) const
+{
+	// Pickup preview is driven by UItemPickupPreviewSubsystem, nothing in the base ticks unless a subclass turns it on
+	return GetStateProfile(State).bTick;
+}
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "ProjectMarcus/Interfaces/SignificanceInterface.h"
+#include "ProjectMarcus/Interactables/ItemStateProfile.h"
 #include "ItemBase.generated.h"
 
 UENUM(BlueprintType)
@@ -35,11 +37,23 @@ enum class EItemState : uint8
 	EIS_Equipped UMETA(DisplayName = "Equipped"),
 	EIS_Drop	UMETA(DisplayName = "Drop"),
 	EIS_Falling UMETA(DisplayName = "Falling"),
+	EIS_Pooled UMETA(DisplayName = "Pooled"), // dormant in UItemPoolSubsystem, hidden with no collision or tick
 	EIR_Max UMETA(DisplayName = "InvalidMAX")
 };
 
+// Packed visual state of an item, each bit is one render-state toggle
+enum class EItemVisualFlags : uint8
+{
+	None = 0,
+	CustomDepth = 1 << 0,
+	Glow = 1 << 1,
+	PickupWidget = 1 << 2,
+	All = CustomDepth | Glow | PickupWidget
+};
+ENUM_CLASS_FLAGS(EItemVisualFlags);
+
 UCLASS()
-class PROJECTMARCUS_API AItemBase : public AActor
+class PROJECTMARCUS_API AItemBase : public AActor, public ISignificanceInterface
 {
 	GENERATED_BODY()
 	
@@ -48,14 +62,50 @@ public:
 	AItemBase();
 
 public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
-
 	virtual void UpdateToState(EItemState State);
 
+	// Hidden items (picked up, pooled) score 0, the equipped weapon is always significant
+	virtual float GetSignificanceStateScale() const override;
+	virtual bool IsAlwaysSignificant() const override;
+
+	// Slows the actor tick down in the lower buckets, dormant items don't tick at all
+	virtual void OnSignificanceUpdated(float Significance, ESignificanceBucket Bucket, float TickInterval) override;
+
+	// Books the tick (subclass Tick included) under the current significance bucket's stat
+	virtual void TickActor(float DeltaTime, ELevelTick TickType, FActorTickFunction& ThisTickFunction) override;
+
+	// Clears per use state before the item goes back into UItemPoolSubsystem
+	virtual void ResetForReuse();
+
+	const FItemStateProfile& GetStateProfile(EItemState State) const { return StateProfiles[(int32)State]; }
+
+	// Sets Component up for Profile, only touching what doesn't match already
+	static void ApplyStateProfile(class UPrimitiveComponent* Component, const FItemStateProfile& Profile);
+
+	// Blown out of waiting for pickup by an explosion. Tumbles with physics, then waits for pickup again wherever it lands
+	void ApplyKnockback(const FVector& Origin, float Radius, float Strength);
+
 	// Toggles any pickup widgets, vfx, anything that should be turned on/off when the player is looking at the item and in range
 	void SetPickupItemVisuals(bool bIsVisible);
 
+	// Pushes only the visual bits that changed since the last flush to the components. Called once per frame by UItemVisualSubsystem
+	void FlushVisualState();
+
+	// Picks the pulse curve and time for the current state. Returns false if this state has no pulse
+	bool GetPulseCurveSample(bool& bOutInterpPulse, float& OutTime) const;
+
+	// Read only, safe to call off the game thread
+	FVector EvaluatePulseCurve(bool bInterpPulse, float Time) const;
+
+	// Pushes pulse curve values into the dynamic material
+	void ApplyPulseCurveValues(const FVector& CurveValue);
+
+	// Where this item should be this frame of the pickup preview. Called once per frame by UItemPickupPreviewSubsystem
+	bool ComputePickupPreviewTransform(const FVector& TargetLocation, const FRotator& CameraRotation, float DeltaTime, FTransform& OutTransform) const;
+
+	// Which of the character's pickup locations this item interps to
+	int32 GetPickupPreviewLocationIndex() const;
+
 	class USkeletalMeshComponent* GetItemMesh() { return ItemMesh; }
 
 	int32 GetItemCount() { return ItemCount; }
@@ -65,47 +115,70 @@ public:
 
 	void SetSwapInsteadOfPickup(bool bInSwapInsteadOfPickup) { bSwapInsteadOfPickup = bInSwapInsteadOfPickup; }
 
+	// Set by the character when this item enters/leaves its pickup range
+	void SetCharacterInPickupRange(class AProjectMarcusCharacter* InCharacter) { CachedCharInPickupRange = InCharacter; }
+	AProjectMarcusCharacter* GetCharacterInPickupRange() const { return CachedCharInPickupRange; }
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void OnConstruction(const FTransform& Transform) override;
 
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	virtual void InitCustomDepth();
 	
 	// [Outline + Color Tint] allow/disallow custom depth for the mesh 
-	virtual void SetCustomDepth(bool bEnabled);
+	void SetCustomDepth(bool bEnabled);
 	
 	void SetGlowMaterial(bool bEnabled);
 
 	void SetPickupWidgetVisibility(bool bVisible);
 
-	UFUNCTION()
-	void OnBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
-	UFUNCTION()
-	void OnEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+	// Render-state side of the setters above, only called when the bit actually changed
+	virtual void ApplyCustomDepth(bool bEnabled);
+	void ApplyGlowMaterial(bool bEnabled);
+	void ApplyPickupWidgetVisibility(bool bVisible);
+
+	// Records the desired value and queues a flush if it differs from what's applied
+	void SetDesiredVisualFlag(EItemVisualFlags Flag, bool bEnabled);
 
-	// handles item interpolation when in the EIS_PreviewInterping state
-	void CheckForItemPreviewInterp(float DeltaTime);
+	// Bakes the class defaults curves into a UItemCurveTable when the class loads (or the first time an item asks, for classes that weren't loaded)
+	class UItemCurveTable* GetClassCurveTable() const;
 
-	void GetPickupInterpLocation(FVector& OutInterpLocation);
+	// Curve lookups go through the baked CurveTable when there is one, otherwise the raw curves
+	bool HasPickupPreviewZCurve() const;
+	float EvaluatePickupPreviewZ(float Time) const;
+	float EvaluatePickupScale(float Time) const;
 
 	void StartPickupPreview();
 	void FinishPickupPreview();
 
+	// Adds/removes this item from the world pickup index the character queries for items in range
 	void EnableProximityTrigger();
 	void DisableProximityTrigger();
 
-	void EnableMeshPhysics();
-	void DisableMeshPhysycs();
-
-	void SetMeshVibility(bool bVisible);
-
 	void PlayPickupSound();
 	void PlayEquipSound();
 
-	void UpdatePulseCurveValues();
-	void ResetPulseTimer();
+	// Registers/unregisters with the pulse animation in UItemVisualSubsystem based off ItemState
+	void UpdatePulseRegistration();
+
+	// Whether the actor needs to tick while in State. Idle items are driven entirely by subsystems
+	bool ShouldTickInState(EItemState State) const;
+
+	// Ticks if the state needs it and significance allows it
+	void UpdateTickEnabled();
+
+	// Bucket from the USignificanceSubsystem
+	ESignificanceBucket SignificanceBucket = ESignificanceBucket::ESB_High;
 
 
 	// Item Mesh
@@ -116,10 +189,6 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadonly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	class UWidgetComponent* PickupWidget = nullptr;
 
-	// Detects if we are close enough to the pickup to perform vision checks (TODO: Which can also be done by the dot of our forward facing direction and the direction of the closest pickup)
-	UPROPERTY(EditAnywhere, BlueprintReadonly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
-	class USphereComponent* ProximityTrigger = nullptr;
-
 	UPROPERTY(EditAnywhere, BlueprintReadonly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	FName ItemName = FName("Default");
 
@@ -133,6 +202,14 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	EItemState ItemState = EItemState::EIS_PickupWaiting;
 
+	// Collision, physics, visibility, pickup trigger and tick per state, applied by UpdateToState
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true", ArraySizeEnum = "EItemState"))
+	FItemStateProfile StateProfiles[(int32)EItemState::EIR_Max];
+
+	// Lookup tables baked from the curves below, owned by the class defaults and shared by every item of the class
+	UPROPERTY(Transient)
+	class UItemCurveTable* CurveTable = nullptr;
+
 	// The curve asset to use for the items Z location when interping on pickup
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	class UCurveFloat* ItemZPickupPreviewCurve;
@@ -155,6 +232,14 @@ protected:
 	
 	FTimerHandle ItemInterpHandle;
 
+	void FinishKnockback();
+
+	FTimerHandle KnockbackTimer;
+
+	// How long a knocked back item tumbles before it can be picked up again
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
+	float KnockbackSettleTime = 1.f;
+
 	// Duration matches the curve length
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	float ItemPickupPreviewDuration = 0.7f;
@@ -205,7 +290,8 @@ protected:
 	// Curve to drive the Dynamic Material parameters
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	class UCurveVector* PulseCurve = nullptr;
-	FTimerHandle PulseTimer;
+	// World time the pulse curve started looping from
+	float PulseStartTime = 0.f;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	float PulseCurveDuration = 5.f;
@@ -228,4 +314,17 @@ protected:
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory", meta = (AllowPrivateAccess = "true"))
 	bool bSwapInsteadOfPickup = false;
+
+private:
+	// What the item wants to look like vs what was last pushed to the components
+	EItemVisualFlags DesiredVisualState = EItemVisualFlags::None;
+	EItemVisualFlags AppliedVisualState = EItemVisualFlags::None;
+
+	// Nothing has been pushed yet, the first flush applies every bit
+	bool bVisualStateApplied = false;
+
+	bool bVisualFlushQueued = false;
+
+	// Whether this item is in the UItemSpatialSubsystem
+	bool bInProximityIndex = false;
 };
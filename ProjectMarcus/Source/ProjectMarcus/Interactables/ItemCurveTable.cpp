@@ -0,0 +1,161 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Interactables/ItemCurveTable.h"
+#include "Curves/CurveFloat.h"
+#include "Curves/CurveVector.h"
+
+void FBakedItemCurve::Bake(TFunctionRef<FVector(float)> Evaluate, float InMinTime, float InMaxTime, int32 Resolution, int32 MaxResolution, float MaxErrorBound)
+{
+	MinTime = InMinTime;
+	const float Duration = FMath::Max(InMaxTime - InMinTime, KINDA_SMALL_NUMBER);
+
+	Resolution = FMath::Max(Resolution, 2);
+	MaxResolution = FMath::Max(MaxResolution, Resolution);
+	for (;;)
+	{
+		const float SampleStep = Duration / (Resolution - 1);
+		InvSampleStep = 1.f / SampleStep;
+
+		Samples.SetNumUninitialized(Resolution);
+		for (int32 Idx = 0; Idx < Resolution; ++Idx)
+		{
+			Samples[Idx] = Evaluate(MinTime + Idx * SampleStep);
+		}
+
+		// Checked densely within each segment, the worst point isn't at the midpoint for keys with tangents or steps
+		MaxError = 0.f;
+		for (int32 Idx = 0; Idx < Resolution - 1; ++Idx)
+		{
+			for (int32 Sub = 1; Sub < ErrorSamplesPerSegment; ++Sub)
+			{
+				const float Time = MinTime + (Idx + static_cast<float>(Sub) / ErrorSamplesPerSegment) * SampleStep;
+				MaxError = FMath::Max(MaxError, (Evaluate(Time) - this->Evaluate(Time)).GetAbsMax());
+			}
+		}
+
+		if (MaxError <= MaxErrorBound || Resolution >= MaxResolution)
+		{
+			break;
+		}
+		Resolution = FMath::Min(Resolution * 2, MaxResolution);
+	}
+}
+
+void FBakedItemCurve::Reset()
+{
+	Samples.Empty();
+	MinTime = 0.f;
+	InvSampleStep = 0.f;
+	MaxError = 0.f;
+}
+
+void UItemCurveTable::Bake(const UCurveFloat* PickupPreviewZCurve, const UCurveFloat* ScaleCurve, const UCurveVector* PulseCurve, const UCurveVector* InterpPulseCurve)
+{
+#if WITH_EDITOR
+	WatchSourceCurves(false);
+#endif
+
+	SourcePickupPreviewZCurve = PickupPreviewZCurve;
+	SourceScaleCurve = ScaleCurve;
+	SourcePulseCurve = PulseCurve;
+	SourceInterpPulseCurve = InterpPulseCurve;
+
+	BakeFloatCurve(PickupPreviewZCurve, BakedPickupPreviewZ);
+	BakeFloatCurve(ScaleCurve, BakedScale);
+	BakeVectorCurve(PulseCurve, BakedPulse);
+	BakeVectorCurve(InterpPulseCurve, BakedInterpPulse);
+
+	BakedMaxError = FMath::Max(
+		FMath::Max(BakedPickupPreviewZ.GetMaxError(), BakedScale.GetMaxError()),
+		FMath::Max(BakedPulse.GetMaxError(), BakedInterpPulse.GetMaxError()));
+
+	if (BakedMaxError > MaxErrorBound)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UItemCurveTable::Bake, %s max error %f is over the bound %f at max resolution %d"), *GetPathName(), BakedMaxError, MaxErrorBound, MaxSampleResolution);
+	}
+
+#if WITH_EDITOR
+	// The table outlives PIE sessions on the class defaults, so curve edits have to re-bake it or PIE plays the old values
+	WatchSourceCurves(true);
+#endif
+}
+
+#if WITH_EDITOR
+void UItemCurveTable::WatchSourceCurves(bool bWatch)
+{
+	const UCurveBase* Sources[] = { SourcePickupPreviewZCurve, SourceScaleCurve, SourcePulseCurve, SourceInterpPulseCurve };
+	for (const UCurveBase* Source : Sources)
+	{
+		if (Source == nullptr)
+		{
+			continue;
+		}
+
+		UCurveBase* MutableSource = const_cast<UCurveBase*>(Source);
+		MutableSource->OnUpdateCurve.RemoveAll(this);
+		if (bWatch)
+		{
+			MutableSource->OnUpdateCurve.AddUObject(this, &UItemCurveTable::OnSourceCurveUpdated);
+		}
+	}
+}
+
+void UItemCurveTable::OnSourceCurveUpdated(UCurveBase* Curve, EPropertyChangeType::Type ChangeType)
+{
+	Bake(SourcePickupPreviewZCurve, SourceScaleCurve, SourcePulseCurve, SourceInterpPulseCurve);
+}
+#endif
+
+float UItemCurveTable::EvaluatePickupPreviewZ(float Time) const
+{
+	return BakedPickupPreviewZ.IsBaked() ? BakedPickupPreviewZ.Evaluate(Time).X : 0.f;
+}
+
+float UItemCurveTable::EvaluateScale(float Time) const
+{
+	return BakedScale.IsBaked() ? BakedScale.Evaluate(Time).X : 1.f;
+}
+
+FVector UItemCurveTable::EvaluatePulse(float Time) const
+{
+	return BakedPulse.IsBaked() ? BakedPulse.Evaluate(Time) : FVector::ZeroVector;
+}
+
+FVector UItemCurveTable::EvaluateInterpPulse(float Time) const
+{
+	return BakedInterpPulse.IsBaked() ? BakedInterpPulse.Evaluate(Time) : FVector::ZeroVector;
+}
+
+void UItemCurveTable::BakeFloatCurve(const UCurveFloat* Curve, FBakedItemCurve& OutBaked)
+{
+	OutBaked.Reset();
+	if (Curve == nullptr)
+	{
+		return;
+	}
+
+	// The curve might not have finished loading its keys yet
+	const_cast<UCurveFloat*>(Curve)->ConditionalPostLoad();
+
+	float MinTime = 0.f;
+	float MaxTime = 0.f;
+	Curve->GetTimeRange(MinTime, MaxTime);
+	OutBaked.Bake([Curve](float Time) { return FVector(Curve->GetFloatValue(Time), 0.f, 0.f); }, MinTime, MaxTime, SampleResolution, MaxSampleResolution, MaxErrorBound);
+}
+
+void UItemCurveTable::BakeVectorCurve(const UCurveVector* Curve, FBakedItemCurve& OutBaked)
+{
+	OutBaked.Reset();
+	if (Curve == nullptr)
+	{
+		return;
+	}
+
+	// The curve might not have finished loading its keys yet
+	const_cast<UCurveVector*>(Curve)->ConditionalPostLoad();
+
+	float MinTime = 0.f;
+	float MaxTime = 0.f;
+	Curve->GetTimeRange(MinTime, MaxTime);
+	OutBaked.Bake([Curve](float Time) { return Curve->GetVectorValue(Time); }, MinTime, MaxTime, SampleResolution, MaxSampleResolution, MaxErrorBound);
+}
@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ItemCurveTable.generated.h"
+
+// Fixed resolution samples of a curve. Constant time lookup with linear interpolation between samples
+USTRUCT()
+struct PROJECTMARCUS_API FBakedItemCurve
+{
+	GENERATED_BODY()
+
+	// Samples Evaluate over [InMinTime, InMaxTime], doubling the resolution until the measured error is within MaxErrorBound (or MaxResolution is hit)
+	void Bake(TFunctionRef<FVector(float)> Evaluate, float InMinTime, float InMaxTime, int32 Resolution, int32 MaxResolution, float MaxErrorBound);
+
+	void Reset();
+
+	bool IsBaked() const { return Samples.Num() > 1; }
+
+	FVector Evaluate(float Time) const
+	{
+		const int32 LastIdx = Samples.Num() - 1;
+		const float Alpha = FMath::Clamp((Time - MinTime) * InvSampleStep, 0.f, static_cast<float>(LastIdx));
+		const int32 Idx = FMath::Min(FMath::FloorToInt(Alpha), LastIdx - 1);
+		return FMath::Lerp(Samples[Idx], Samples[Idx + 1], Alpha - Idx);
+	}
+
+	// Largest error measured against the source curve during the bake, checked at ErrorSamplesPerSegment points in
+	// every segment. Error between those points can only exceed it by how much the curve bends in 1/ErrorSamplesPerSegment of a segment
+	float GetMaxError() const { return MaxError; }
+
+	static constexpr int32 ErrorSamplesPerSegment = 8;
+
+private:
+	TArray<FVector> Samples;
+	float MinTime = 0.f;
+	float InvSampleStep = 0.f;
+	float MaxError = 0.f;
+};
+
+/**
+ * An item class's pickup preview, scale and pulse curves baked into lookup tables. Built from the curves on the
+ * class defaults when the class loads and shared by every item of the class. In the editor it re-bakes whenever
+ * one of its curves is edited.
+ */
+UCLASS(Config = Game)
+class PROJECTMARCUS_API UItemCurveTable : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// Re-samples every curve, a null curve leaves its table unbaked
+	void Bake(const class UCurveFloat* PickupPreviewZCurve, const class UCurveFloat* ScaleCurve, const class UCurveVector* PulseCurve, const class UCurveVector* InterpPulseCurve);
+
+	float EvaluatePickupPreviewZ(float Time) const;
+	float EvaluateScale(float Time) const;
+	FVector EvaluatePulse(float Time) const;
+	FVector EvaluateInterpPulse(float Time) const;
+
+	bool HasPickupPreviewZ() const { return BakedPickupPreviewZ.IsBaked(); }
+	bool HasScale() const { return BakedScale.IsBaked(); }
+	bool HasPulse() const { return BakedPulse.IsBaked(); }
+	bool HasInterpPulse() const { return BakedInterpPulse.IsBaked(); }
+
+	// Largest error of any baked curve, for checking the bound was actually met
+	float GetBakedMaxError() const { return BakedMaxError; }
+
+private:
+#if WITH_EDITOR
+	// Binds (or unbinds) OnSourceCurveUpdated on every source curve
+	void WatchSourceCurves(bool bWatch);
+
+	void OnSourceCurveUpdated(class UCurveBase* Curve, EPropertyChangeType::Type ChangeType);
+#endif
+
+	void BakeFloatCurve(const class UCurveFloat* Curve, FBakedItemCurve& OutBaked);
+	void BakeVectorCurve(const class UCurveVector* Curve, FBakedItemCurve& OutBaked);
+
+	// Samples per curve to start baking with
+	UPROPERTY(Config)
+	int32 SampleResolution = 64;
+
+	// Resolution is doubled up to this until the error bound is met
+	UPROPERTY(Config)
+	int32 MaxSampleResolution = 1024;
+
+	// Max allowed difference between the table and the source curve
+	UPROPERTY(Config)
+	float MaxErrorBound = 0.001f;
+
+	float BakedMaxError = 0.f;
+
+	// Curves the tables were baked from
+	UPROPERTY(Transient)
+	const class UCurveFloat* SourcePickupPreviewZCurve = nullptr;
+
+	UPROPERTY(Transient)
+	const class UCurveFloat* SourceScaleCurve = nullptr;
+
+	UPROPERTY(Transient)
+	const class UCurveVector* SourcePulseCurve = nullptr;
+
+	UPROPERTY(Transient)
+	const class UCurveVector* SourceInterpPulseCurve = nullptr;
+
+	FBakedItemCurve BakedPickupPreviewZ;
+	FBakedItemCurve BakedScale;
+	FBakedItemCurve BakedPulse;
+	FBakedItemCurve BakedInterpPulse;
+};
@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Interactables/ItemPickupPreviewSubsystem.h"
+#include "ProjectMarcus/Interactables/ItemBase.h"
+#include "ProjectMarcus/Character/ProjectMarcusCharacter.h"
+#include "ProjectMarcus/ProjectMarcus.h"
+#include "Camera/CameraComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("Item Pickup Preview"), STAT_ItemPickupPreview, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Pickup Previews"), STAT_ItemPickupPreviews, STATGROUP_ProjectMarcus);
+
+void UItemPickupPreviewSubsystem::Deinitialize()
+{
+	PreviewItems.Empty();
+	Views.Empty();
+
+	Super::Deinitialize();
+}
+
+void UItemPickupPreviewSubsystem::AddPreview(AItemBase* Item)
+{
+	if (Item)
+	{
+		PreviewItems.AddUnique(Item);
+	}
+}
+
+void UItemPickupPreviewSubsystem::RemovePreview(AItemBase* Item)
+{
+	PreviewItems.RemoveSwap(Item);
+}
+
+void UItemPickupPreviewSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ItemPickupPreview);
+
+	Views.Reset();
+
+	// Finishing a preview happens on a timer, never in here, so the list is stable while we walk it
+	for (int32 Idx = PreviewItems.Num() - 1; Idx >= 0; --Idx)
+	{
+		AItemBase* Item = PreviewItems[Idx].Get();
+		if (Item == nullptr)
+		{
+			PreviewItems.RemoveAtSwap(Idx);
+			continue;
+		}
+
+		const FPreviewView* View = GetView(Item->GetCharacterInPickupRange());
+		if (View == nullptr)
+		{
+			UE_LOG(LogTemp, Error, TEXT("CachedCharInPickupRange is invalid!"));
+			continue;
+		}
+
+		const int32 LocationIdx = Item->GetPickupPreviewLocationIndex();
+		const FVector TargetLocation = View->PickupLocations.IsValidIndex(LocationIdx) ? View->PickupLocations[LocationIdx] : FVector::ZeroVector;
+
+		FTransform PreviewTransform;
+		if (Item->ComputePickupPreviewTransform(TargetLocation, View->CameraRotation, DeltaTime, PreviewTransform))
+		{
+			Item->SetActorTransform(PreviewTransform, false, nullptr, ETeleportType::TeleportPhysics);
+			INC_DWORD_STAT(STAT_ItemPickupPreviews);
+		}
+	}
+}
+
+TStatId UItemPickupPreviewSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UItemPickupPreviewSubsystem, STATGROUP_Tickables);
+}
+
+const UItemPickupPreviewSubsystem::FPreviewView* UItemPickupPreviewSubsystem::GetView(AProjectMarcusCharacter* Character)
+{
+	if (Character == nullptr)
+	{
+		return nullptr;
+	}
+
+	for (const FPreviewView& View : Views)
+	{
+		if (View.Character.Get() == Character)
+		{
+			return &View;
+		}
+	}
+
+	FPreviewView& View = Views.AddDefaulted_GetRef();
+	View.Character = Character;
+	UCameraComponent* CharCamComp = Character->GetFollowCamera();
+	View.CameraRotation = CharCamComp ? CharCamComp->GetComponentRotation() : Character->GetControlRotation();
+
+	View.PickupLocations.SetNum(Character->GetNumPickupLocations());
+	for (int32 Idx = 0; Idx < View.PickupLocations.Num(); ++Idx)
+	{
+		Character->GetPickupLocationLocation(Idx, View.PickupLocations[Idx]);
+	}
+	return &View;
+}
@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProjectMarcus/Subsystems/ProjectMarcusTickableSubsystem.h"
+#include "ItemPickupPreviewSubsystem.generated.h"
+
+/**
+ * Moves every item that is interping to its pickup location in one pass per frame.
+ * Camera rotation and pickup locations are read once per character, then each item gets a single teleporting
+ * SetActorTransform (no sweep) instead of separate location/rotation/scale updates.
+ */
+UCLASS()
+class PROJECTMARCUS_API UItemPickupPreviewSubsystem : public UProjectMarcusTickableSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	void AddPreview(class AItemBase* Item);
+	void RemovePreview(AItemBase* Item);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FPreviewView
+	{
+		TWeakObjectPtr<class AProjectMarcusCharacter> Character;
+		FRotator CameraRotation = FRotator::ZeroRotator;
+		TArray<FVector, TInlineAllocator<8>> PickupLocations;
+	};
+
+	// Finds or builds this frame's view for the character
+	const FPreviewView* GetView(AProjectMarcusCharacter* Character);
+
+	TArray<TWeakObjectPtr<AItemBase>> PreviewItems;
+
+	// Per frame scratch, one entry per character with items in flight
+	TArray<FPreviewView> Views;
+};
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Interactables/ItemPoolSubsystem.h"
+#include "ProjectMarcus/Interactables/ItemBase.h"
+#include "ProjectMarcus/ProjectMarcus.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Items"), STAT_PooledItems, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Pool Reuses"), STAT_ItemPoolReuses, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Pool Spawns"), STAT_ItemPoolSpawns, STATGROUP_ProjectMarcus);
+
+void UItemPoolSubsystem::Deinitialize()
+{
+	for (const auto& Pool : Pools)
+	{
+		DEC_DWORD_STAT_BY(STAT_PooledItems, Pool.Value.Num());
+	}
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
+
+AItemBase* UItemPoolSubsystem::AcquireItem(TSubclassOf<AItemBase> ItemClass, const FTransform& Transform)
+{
+	if (ItemClass == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (TArray<TWeakObjectPtr<AItemBase>>* Pool = Pools.Find(ItemClass))
+	{
+		while (Pool->Num() > 0)
+		{
+			AItemBase* Item = Pool->Pop(false).Get();
+			DEC_DWORD_STAT(STAT_PooledItems);
+			if (Item == nullptr || Item->IsPendingKill())
+			{
+				continue;
+			}
+
+			Item->SetActorTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+			Item->UpdateToState(EItemState::EIS_PickupWaiting);
+			INC_DWORD_STAT(STAT_ItemPoolReuses);
+			return Item;
+		}
+	}
+
+	// BeginPlay puts new items into EIS_PickupWaiting
+	return SpawnItem(ItemClass, Transform);
+}
+
+void UItemPoolSubsystem::ReleaseItem(AItemBase* Item)
+{
+	if (Item == nullptr || Item->IsPendingKill())
+	{
+		return;
+	}
+
+	TArray<TWeakObjectPtr<AItemBase>>& Pool = Pools.FindOrAdd(Item->GetClass());
+	if (Pool.Num() >= MaxPooledPerClass)
+	{
+		Item->Destroy();
+		return;
+	}
+
+	Item->ResetForReuse();
+	Item->UpdateToState(EItemState::EIS_Pooled);
+	Pool.Add(Item);
+	INC_DWORD_STAT(STAT_PooledItems);
+}
+
+void UItemPoolSubsystem::Prewarm(TSubclassOf<AItemBase> ItemClass, int32 Count)
+{
+	const int32 NumToSpawn = FMath::Min(Count, MaxPooledPerClass) - GetNumPooled(ItemClass);
+	for (int32 Idx = 0; Idx < NumToSpawn; ++Idx)
+	{
+		ReleaseItem(SpawnItem(ItemClass, FTransform::Identity));
+	}
+}
+
+int32 UItemPoolSubsystem::GetNumPooled(TSubclassOf<AItemBase> ItemClass) const
+{
+	const TArray<TWeakObjectPtr<AItemBase>>* Pool = Pools.Find(ItemClass);
+	return Pool ? Pool->Num() : 0;
+}
+
+AItemBase* UItemPoolSubsystem::SpawnItem(TSubclassOf<AItemBase> ItemClass, const FTransform& Transform)
+{
+	if (ItemClass == nullptr || GetWorld() == nullptr)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	INC_DWORD_STAT(STAT_ItemPoolSpawns);
+	return GetWorld()->SpawnActor<AItemBase>(ItemClass, Transform, SpawnParams);
+}
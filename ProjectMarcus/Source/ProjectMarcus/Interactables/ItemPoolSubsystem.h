@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ItemPoolSubsystem.generated.h"
+
+/**
+ * Per class pools of dormant item actors.
+ * Collected items are parked in EIS_Pooled (hidden, no collision, no tick) instead of being destroyed, and the next
+ * acquire of that class reuses one instead of paying for a full SpawnActor + component registration.
+ */
+UCLASS(Config = Game)
+class PROJECTMARCUS_API UItemPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Reuses a pooled item of ItemClass (or spawns one) at Transform, in EIS_PickupWaiting
+	class AItemBase* AcquireItem(TSubclassOf<AItemBase> ItemClass, const FTransform& Transform);
+
+	template<class T>
+	T* AcquireItem(TSubclassOf<T> ItemClass, const FTransform& Transform)
+	{
+		return Cast<T>(AcquireItem(TSubclassOf<AItemBase>(*ItemClass), Transform));
+	}
+
+	// Parks the item in the pool, or destroys it if the pool for its class is full
+	void ReleaseItem(AItemBase* Item);
+
+	// Spawns items up front so the first drops don't pay for spawning
+	void Prewarm(TSubclassOf<AItemBase> ItemClass, int32 Count);
+
+	int32 GetNumPooled(TSubclassOf<AItemBase> ItemClass) const;
+
+private:
+	AItemBase* SpawnItem(TSubclassOf<AItemBase> ItemClass, const FTransform& Transform);
+
+	// Items past this per class get destroyed on release
+	UPROPERTY(Config)
+	int32 MaxPooledPerClass = 128;
+
+	TMap<UClass*, TArray<TWeakObjectPtr<AItemBase>>> Pools;
+};
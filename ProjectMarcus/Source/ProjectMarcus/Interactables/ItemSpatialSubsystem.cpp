@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Interactables/ItemSpatialSubsystem.h"
+#include "ProjectMarcus/Interactables/ItemBase.h"
+#include "ProjectMarcus/ProjectMarcus.h"
+
+DECLARE_CYCLE_STAT(TEXT("Item Spatial Query"), STAT_ItemSpatialQuery, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Indexed Pickup Items"), STAT_IndexedPickupItems, STATGROUP_ProjectMarcus);
+
+void UItemSpatialSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_IndexedPickupItems, ItemCells.Num());
+	Cells.Empty();
+	ItemCells.Empty();
+
+	Super::Deinitialize();
+}
+
+void UItemSpatialSubsystem::RegisterItem(AItemBase* Item)
+{
+	if (Item == nullptr)
+	{
+		return;
+	}
+
+	// Moving an already indexed item is just a remove + add
+	UnregisterItem(Item);
+
+	const FVector Location = Item->GetActorLocation();
+	const FIntVector CellCoord = GetCellCoord(Location);
+
+	Cells.FindOrAdd(CellCoord).Add({ MakeWeakObjectPtr(Item), Location });
+	ItemCells.Add(Item->GetUniqueID(), CellCoord);
+	INC_DWORD_STAT(STAT_IndexedPickupItems);
+}
+
+void UItemSpatialSubsystem::UnregisterItem(AItemBase* Item)
+{
+	if (Item == nullptr)
+	{
+		return;
+	}
+
+	FIntVector CellCoord;
+	if (!ItemCells.RemoveAndCopyValue(Item->GetUniqueID(), CellCoord))
+	{
+		return;
+	}
+	DEC_DWORD_STAT(STAT_IndexedPickupItems);
+
+	if (TArray<FIndexedItem>* Cell = Cells.Find(CellCoord))
+	{
+		Cell->RemoveAllSwap([Item](const FIndexedItem& Entry) { return Entry.Item.Get() == Item || !Entry.Item.IsValid(); });
+		if (Cell->Num() == 0)
+		{
+			Cells.Remove(CellCoord);
+		}
+	}
+}
+
+void UItemSpatialSubsystem::QueryItemsInRadius(const FVector& Origin, float Radius, TArray<AItemBase*>& OutItems) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ItemSpatialQuery);
+
+	const FIntVector MinCell = GetCellCoord(Origin - FVector(Radius));
+	const FIntVector MaxCell = GetCellCoord(Origin + FVector(Radius));
+	const float RadiusSq = Radius * Radius;
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				const TArray<FIndexedItem>* Cell = Cells.Find(FIntVector(X, Y, Z));
+				if (Cell == nullptr)
+				{
+					continue;
+				}
+
+				for (const FIndexedItem& Entry : *Cell)
+				{
+					// Use the location stored at insert time, a waiting item doesn't move so there's no need to touch the actor
+					if (FVector::DistSquared(Entry.Location, Origin) <= RadiusSq)
+					{
+						if (AItemBase* Item = Entry.Item.Get())
+						{
+							OutItems.Add(Item);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+FIntVector UItemSpatialSubsystem::GetCellCoord(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize),
+		FMath::FloorToInt(Location.Z / CellSize));
+}
@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ItemSpatialSubsystem.generated.h"
+
+/**
+ * Uniform grid of every item that is waiting to be picked up.
+ * Items only move in/out of the grid when they change state (a waiting item never moves), so the character can find
+ * what it's in range of with a radius query instead of every item owning its own overlap trigger.
+ */
+UCLASS(Config = Game)
+class PROJECTMARCUS_API UItemSpatialSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Inserts the item into the cell at its current location (re-inserts it if it was already indexed)
+	void RegisterItem(class AItemBase* Item);
+
+	void UnregisterItem(AItemBase* Item);
+
+	// Appends every indexed item within Radius of Origin to OutItems
+	void QueryItemsInRadius(const FVector& Origin, float Radius, TArray<AItemBase*>& OutItems) const;
+
+	int32 GetNumIndexedItems() const { return ItemCells.Num(); }
+
+private:
+	struct FIndexedItem
+	{
+		TWeakObjectPtr<AItemBase> Item;
+		FVector Location;
+	};
+
+	FIntVector GetCellCoord(const FVector& Location) const;
+
+	// Edge length of one cell. Roughly the pickup range so a query only touches a few cells
+	UPROPERTY(Config)
+	float CellSize = 400.f;
+
+	// Cell coordinate -> items inside that cell
+	TMap<FIntVector, TArray<FIndexedItem>> Cells;
+
+	// Item unique id -> cell it was inserted into (so removal doesn't depend on where the item is now)
+	TMap<uint32, FIntVector> ItemCells;
+};
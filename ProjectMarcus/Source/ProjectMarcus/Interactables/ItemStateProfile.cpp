@@ -0,0 +1,5 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Interactables/ItemStateProfile.h"
+
+const FName FItemStateProfile::FallingCollisionProfile(TEXT("ItemFalling"));
@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/CollisionProfile.h"
+#include "ItemStateProfile.generated.h"
+
+/**
+ * How an item's components are set up while it's in one EItemState. Applied in one go at the end of every state change
+ * and only the fields that differ from the components current setup are touched, so repeating a state or moving between
+ * states with the same setup (pickup -> preview) costs nothing.
+ */
+USTRUCT(BlueprintType)
+struct PROJECTMARCUS_API FItemStateProfile
+{
+	GENERATED_BODY()
+
+	// Profile from DefaultEngine.ini, sets collision enabled, object type and every response in one call
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item State")
+	FName CollisionProfile = UCollisionProfile::NoCollision_ProfileName;
+
+	// Physics and gravity on the mesh
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item State")
+	bool bSimulatePhysics = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item State")
+	bool bMeshVisible = true;
+
+	// Whole actor hidden with collision off (pooled)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item State")
+	bool bActorDormant = false;
+
+	// In the world pickup index the character queries for items in range
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item State")
+	bool bProximityTrigger = false;
+
+	// Actor tick, still subject to the items significance bucket
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item State")
+	bool bTick = false;
+
+	// Physics only, blocks WorldStatic and ignores everything else
+	static const FName FallingCollisionProfile;
+};
@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Interactables/ItemVisualSubsystem.h"
+#include "ProjectMarcus/Interactables/ItemBase.h"
+#include "ProjectMarcus/ProjectMarcus.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Async/ParallelFor.h"
+
+DECLARE_CYCLE_STAT(TEXT("Item Visual Flush"), STAT_ItemVisualFlush, STATGROUP_ProjectMarcus);
+DECLARE_CYCLE_STAT(TEXT("Item Pulse Update"), STAT_ItemPulseUpdate, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Pulses Updated"), STAT_ItemPulsesUpdated, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Pulses Culled"), STAT_ItemPulsesCulled, STATGROUP_ProjectMarcus);
+
+void UItemVisualSubsystem::Deinitialize()
+{
+	QueuedItems.Empty();
+	FlushingItems.Empty();
+	PulseItems.Empty();
+	PulseWork.Empty();
+
+	Super::Deinitialize();
+}
+
+void UItemVisualSubsystem::QueueVisualFlush(AItemBase* Item)
+{
+	if (Item)
+	{
+		QueuedItems.Add(Item);
+	}
+}
+
+void UItemVisualSubsystem::RegisterPulse(AItemBase* Item)
+{
+	if (Item)
+	{
+		PulseItems.Add(Item);
+	}
+}
+
+void UItemVisualSubsystem::UnregisterPulse(AItemBase* Item)
+{
+	PulseItems.Remove(Item);
+}
+
+void UItemVisualSubsystem::Tick(float DeltaTime)
+{
+	UpdatePulses();
+	FlushQueuedVisuals();
+}
+
+TStatId UItemVisualSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UItemVisualSubsystem, STATGROUP_Tickables);
+}
+
+void UItemVisualSubsystem::UpdatePulses()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ItemPulseUpdate);
+
+	FVector ViewLocation = FVector::ZeroVector;
+	bool bHasView = false;
+	if (APlayerController* PC = GetWorld()->GetFirstPlayerController())
+	{
+		if (PC->PlayerCameraManager)
+		{
+			ViewLocation = PC->PlayerCameraManager->GetCameraLocation();
+			bHasView = true;
+		}
+	}
+	const float CullDistanceSq = FMath::Square(PulseCullDistance);
+
+	// Gather on the game thread, everything touching the actors stays here
+	PulseWork.Reset();
+	int32 NumCulled = 0;
+	for (auto It = PulseItems.CreateIterator(); It; ++It)
+	{
+		AItemBase* Item = It->Get();
+		if (Item == nullptr)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (!Item->WasRecentlyRendered(PulseRecentlyRenderedTime) ||
+			(bHasView && FVector::DistSquared(Item->GetActorLocation(), ViewLocation) > CullDistanceSq))
+		{
+			++NumCulled;
+			continue;
+		}
+
+		FPulseWork Work;
+		Work.Item = Item;
+		if (Item->GetPulseCurveSample(Work.bInterpPulse, Work.Time))
+		{
+			PulseWork.Add(Work);
+		}
+	}
+
+	// Curve evaluation is read only so it can go wide for big loot rooms
+	ParallelFor(PulseWork.Num(), [this](int32 Idx)
+	{
+		FPulseWork& Work = PulseWork[Idx];
+		Work.Value = Work.Item->EvaluatePulseCurve(Work.bInterpPulse, Work.Time);
+	}, PulseWork.Num() < ParallelPulseThreshold);
+
+	// Material parameters have to be set on the game thread
+	for (const FPulseWork& Work : PulseWork)
+	{
+		Work.Item->ApplyPulseCurveValues(Work.Value);
+	}
+
+	INC_DWORD_STAT_BY(STAT_ItemPulsesUpdated, PulseWork.Num());
+	INC_DWORD_STAT_BY(STAT_ItemPulsesCulled, NumCulled);
+}
+
+void UItemVisualSubsystem::FlushQueuedVisuals()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ItemVisualFlush);
+
+	Swap(QueuedItems, FlushingItems);
+	for (const TWeakObjectPtr<AItemBase>& Item : FlushingItems)
+	{
+		if (Item.IsValid())
+		{
+			Item->FlushVisualState();
+		}
+	}
+	FlushingItems.Reset();
+}
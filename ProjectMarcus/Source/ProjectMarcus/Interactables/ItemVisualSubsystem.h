@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProjectMarcus/Subsystems/ProjectMarcusTickableSubsystem.h"
+#include "ItemVisualSubsystem.generated.h"
+
+/**
+ * Owns all per-frame item visuals so idle items don't need to tick:
+ * - Applies item visual state (outline, glow, pickup widget) once per frame. Items queue themselves when their desired visuals differ from what's on the components.
+ * - Animates the material pulse of every waiting/interping item in one batched pass, skipping items that aren't rendered or are too far away.
+ */
+UCLASS(Config = Game)
+class PROJECTMARCUS_API UItemVisualSubsystem : public UProjectMarcusTickableSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Queues the item for a visual flush at the end of this frame
+	void QueueVisualFlush(class AItemBase* Item);
+
+	// Adds/removes the item from the pulse animation pass
+	void RegisterPulse(AItemBase* Item);
+	void UnregisterPulse(AItemBase* Item);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	void UpdatePulses();
+
+	void FlushQueuedVisuals();
+
+	// Items further than this from the camera keep their last pulse values
+	UPROPERTY(Config)
+	float PulseCullDistance = 4000.f;
+
+	// Items that haven't rendered within this many seconds are skipped
+	UPROPERTY(Config)
+	float PulseRecentlyRenderedTime = 0.2f;
+
+	// Curve evaluation goes wide once this many items need a pulse update
+	UPROPERTY(Config)
+	int32 ParallelPulseThreshold = 64;
+
+	TArray<TWeakObjectPtr<AItemBase>> QueuedItems;
+
+	// Swapped with QueuedItems while flushing so items can re-queue safely
+	TArray<TWeakObjectPtr<AItemBase>> FlushingItems;
+
+	TSet<TWeakObjectPtr<AItemBase>> PulseItems;
+
+	struct FPulseWork
+	{
+		AItemBase* Item = nullptr;
+		bool bInterpPulse = false;
+		float Time = 0.f;
+		FVector Value = FVector::ZeroVector;
+	};
+
+	// Per frame scratch for the items that passed culling
+	TArray<FPulseWork> PulseWork;
+};
@@ -2,12 +2,17 @@
 
 
 #include "ProjectMarcus/Interactables/WeaponItem.h"
+#include "ProjectMarcus/UI/HUDViewModel.h"
+#include "GameFramework/Pawn.h"
 
 
 
 AWeaponItem::AWeaponItem()
 {
 	PrimaryActorTick.bCanEverTick = true;
+
+	// Weapons also tick while falling to keep themselves level
+	StateProfiles[(int32)EItemState::EIS_Falling].bTick = true;
 }
 
 void AWeaponItem::Tick(float DeltaTime)
@@ -25,6 +30,21 @@ void AWeaponItem::Tick(float DeltaTime)
 	}
 }
 
+void AWeaponItem::ResetForReuse()
+{
+	Super::ResetForReuse();
+
+	if (GetWorld())
+	{
+		GetWorldTimerManager().ClearTimer(ThrowWeaponTimer);
+	}
+	bFalling = false;
+	bMovingClip = false;
+
+	// Next user gets the clip this weapon class spawns with
+	CurrentAmmoInClip = GetClass()->GetDefaultObject<AWeaponItem>()->CurrentAmmoInClip;
+}
+
 void AWeaponItem::ThrowWeapon()
 {
 	if (ItemMesh)
@@ -59,12 +79,28 @@ void AWeaponItem::ThrowWeapon()
 void AWeaponItem::ConsumeAmmo(int32 Amt /*= 1*/)
 {
 	CurrentAmmoInClip = FMath::Max(CurrentAmmoInClip - Amt, 0);
+	PushClipToHUD();
 }
 
 void AWeaponItem::ReloadClip(int32 IncommingAmmo)
 {
 	ensureMsgf(CurrentAmmoInClip + IncommingAmmo <= MaxClipCapacity, TEXT("Attempted to reload more than clip capacity"));
 	CurrentAmmoInClip += IncommingAmmo;
+	PushClipToHUD();
+}
+
+void AWeaponItem::PushClipToHUD()
+{
+	if (ItemState != EItemState::EIS_Equipped)
+	{
+		return;
+	}
+
+	// Owned by the character holding it while equipped
+	if (UHUDViewModel* HUDViewModel = UHUDViewModel::Get(Cast<APawn>(GetOwner())))
+	{
+		HUDViewModel->SetClipAmmo(CurrentAmmoInClip);
+	}
 }
 
 void AWeaponItem::StopFalling() // TODO: The pickup in the air is actually still reacting to our widget visibility checking (need to turn that off/remove it from the map immediately I think)
@@ -72,3 +108,4 @@ void AWeaponItem::StopFalling() // TODO: The pickup in the air is actually still
 	bFalling = false;
 	UpdateToState(EItemState::EIS_PickupWaiting);
 }
+
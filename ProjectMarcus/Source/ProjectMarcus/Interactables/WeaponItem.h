@@ -32,6 +32,8 @@ public:
 
 	void SetState(EItemState State) { ItemState = State; }
 
+	virtual void ResetForReuse() override;
+
 	// Adds an impulse and rotation to the weapon
 	void ThrowWeapon();
 
@@ -39,6 +41,9 @@ public:
 
 	void ReloadClip(int32 IncommingAmmo);
 
+	// Sends the clip count to the HUD while this is the equipped weapon
+	void PushClipToHUD();
+
 	int32 GetMaxAmmoCapacity() { return MaxClipCapacity; }
 
 	int32 GetAmmoInClip() { return CurrentAmmoInClip; }
@@ -56,6 +61,8 @@ public:
 	float GetDamage() const { return Damage; }
 	float GetHeadshotDamage() const { return HeadshotDamage; }
 
+	class USoundCue* GetFireLoopSound() const { return FireLoopSound; }
+
 
 protected:
 	void StopFalling();
@@ -91,6 +98,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
 	float HeadshotDamage;
 
+	// Looping gunfire played while the trigger is held. Replaces the per shot fire sound when set
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
+	USoundCue* FireLoopSound = nullptr;
+
 private:
 	FTimerHandle ThrowWeaponTimer;
 	
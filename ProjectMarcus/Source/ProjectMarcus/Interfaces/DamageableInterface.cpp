@@ -0,0 +1,6 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ProjectMarcus/Interfaces/DamageableInterface.h"
+
+// Add default functionality here for any IDamageableInterface functions that are not pure virtual.
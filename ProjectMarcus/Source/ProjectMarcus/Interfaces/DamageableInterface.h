@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "DamageableInterface.generated.h"
+
+// Everything that hit one target during a frame, summed up by UDamageQueueSubsystem
+USTRUCT(BlueprintType)
+struct FResolvedDamage
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Damage")
+	float TotalDamage = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Damage")
+	int32 NumHits = 0;
+
+	// Location of the last hit this frame
+	UPROPERTY(BlueprintReadOnly, Category = "Damage")
+	FVector HitLocation = FVector::ZeroVector;
+
+	// At least one of the hits was a headshot
+	UPROPERTY(BlueprintReadOnly, Category = "Damage")
+	bool bHeadshot = false;
+
+	// Health after all of this frames damage
+	UPROPERTY(BlueprintReadOnly, Category = "Damage")
+	float Health = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Damage")
+	float MaxHealth = 0.f;
+
+	// Health reached zero this frame
+	UPROPERTY(BlueprintReadOnly, Category = "Damage")
+	bool bKilled = false;
+
+	// Instigator and causer of the last hit
+	UPROPERTY(BlueprintReadOnly, Category = "Damage")
+	AController* Instigator = nullptr;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Damage")
+	AActor* DamageCauser = nullptr;
+
+	// Which part of the target took the damage, for targets registered per item (e.g. one instance of an instanced mesh)
+	UPROPERTY(BlueprintReadOnly, Category = "Damage")
+	int32 Item = INDEX_NONE;
+};
+
+// This class does not need to be modified.
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UDamageableInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Something with health in the UDamageQueueSubsystem. Gets one callback per frame it took damage in.
+ */
+class PROJECTMARCUS_API IDamageableInterface
+{
+	GENERATED_BODY()
+
+public:
+	// Health is already updated when this is called. Death (bKilled) should be handled here
+	virtual void OnDamageResolved(const FResolvedDamage& Damage) {}
+
+	// Damage item a hit on Component landed on (ComponentItem is FHitResult::Item / FOverlapResult::ItemIndex). INDEX_NONE for targets with one health
+	virtual int32 GetDamageItem(const UPrimitiveComponent* Component, int32 ComponentItem) const { return INDEX_NONE; }
+};
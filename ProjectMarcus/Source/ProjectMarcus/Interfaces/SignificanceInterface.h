@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "SignificanceInterface.generated.h"
+
+// How often a gameplay actor gets to tick, assigned by USignificanceSubsystem
+UENUM(BlueprintType)
+enum class ESignificanceBucket : uint8
+{
+	ESB_High UMETA(DisplayName = "High"),
+	ESB_Medium UMETA(DisplayName = "Medium"),
+	ESB_Low UMETA(DisplayName = "Low"),
+	ESB_Dormant UMETA(DisplayName = "Dormant"),
+	ESB_Max UMETA(DisplayName = "InvalidMax")
+};
+
+// This class does not need to be modified.
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class USignificanceInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Something scored by the USignificanceSubsystem. The subsystem only scores, the actor decides what a bucket means for
+ * its own ticking (actor tick, movement, animation).
+ */
+class PROJECTMARCUS_API ISignificanceInterface
+{
+	GENERATED_BODY()
+
+public:
+	// Multiplies the distance/visibility score. 0 always ends up dormant (hidden, pooled)
+	virtual float GetSignificanceStateScale() const { return 1.f; }
+
+	// Always in the high bucket, whatever the distance (e.g. a held weapon)
+	virtual bool IsAlwaysSignificant() const { return false; }
+
+	// Called on every rescore. TickInterval is the bucket's interval, 0 means every frame
+	virtual void OnSignificanceUpdated(float Significance, ESignificanceBucket Bucket, float TickInterval) {}
+};
@@ -0,0 +1,132 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Inventory/InventoryComponent.h"
+#include "ProjectMarcus/Interactables/ItemBase.h"
+#include "ProjectMarcus/ProjectMarcus.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Inventory UI Broadcasts"), STAT_InventoryBroadcasts, STATGROUP_ProjectMarcus);
+
+UInventoryComponent::UInventoryComponent()
+{
+	// Only ticks on frames that changed something the UI shows, after everything else has had its turn
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+
+	Slots.Init(nullptr, NumSlots);
+}
+
+void UInventoryComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	FlushNotifications();
+}
+
+int32 UInventoryComponent::AddItem(AItemBase* Item)
+{
+	const int32 Slot = GetFirstFreeSlot();
+	if (Item && Slot != INDEX_NONE)
+	{
+		SetItem(Slot, Item);
+		return Slot;
+	}
+	return INDEX_NONE;
+}
+
+void UInventoryComponent::SetItem(int32 Slot, AItemBase* Item)
+{
+	if (!ensure(IsValidSlot(Slot)))
+	{
+		return;
+	}
+
+	Slots[Slot] = Item;
+	if (Item)
+	{
+		Item->SetInventorySlotIndex(Slot);
+		FreeSlots &= ~(1u << Slot);
+	}
+	else
+	{
+		FreeSlots |= 1u << Slot;
+	}
+}
+
+AItemBase* UInventoryComponent::RemoveItem(int32 Slot)
+{
+	AItemBase* Item = GetItem(Slot);
+	if (Item)
+	{
+		Item->SetInventorySlotIndex(-1);
+		SetItem(Slot, nullptr);
+	}
+	return Item;
+}
+
+void UInventoryComponent::HighlightSlot(int32 Slot)
+{
+	if (PendingHighlightedSlot != Slot)
+	{
+		PendingHighlightedSlot = Slot;
+		MarkNotificationsDirty();
+	}
+}
+
+void UInventoryComponent::NotifyEquipped(int32 OldSlot, AItemBase* NewItem)
+{
+	if (!bEquipPending)
+	{
+		bEquipPending = true;
+		PendingEquipOldSlot = OldSlot;
+	}
+	PendingEquipItem = NewItem;
+	MarkNotificationsDirty();
+}
+
+void UInventoryComponent::FlushNotifications()
+{
+	SetComponentTickEnabled(false);
+
+	if (bEquipPending)
+	{
+		// The slot is read now, the item may only have been put in the inventory after it was equipped
+		AItemBase* NewItem = PendingEquipItem.Get();
+		EquipItemDelegate.Broadcast(PendingEquipOldSlot, NewItem ? NewItem->GetInventorySlotIndex() : -1);
+		INC_DWORD_STAT(STAT_InventoryBroadcasts);
+
+		bEquipPending = false;
+		PendingEquipItem.Reset();
+	}
+
+	if (HighlightedSlot != PendingHighlightedSlot)
+	{
+		if (HighlightedSlot != INDEX_NONE)
+		{
+			HighlightIconDelegate.Broadcast(HighlightedSlot, false);
+			INC_DWORD_STAT(STAT_InventoryBroadcasts);
+		}
+		if (PendingHighlightedSlot != INDEX_NONE)
+		{
+			HighlightIconDelegate.Broadcast(PendingHighlightedSlot, true);
+			INC_DWORD_STAT(STAT_InventoryBroadcasts);
+		}
+		HighlightedSlot = PendingHighlightedSlot;
+	}
+}
+
+void UInventoryComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	bEquipPending = false;
+	PendingEquipItem.Reset();
+}
+
+void UInventoryComponent::MarkNotificationsDirty()
+{
+	if (!IsComponentTickEnabled())
+	{
+		SetComponentTickEnabled(true);
+	}
+}
@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "InventoryComponent.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FEquipItemDelegate, int32, CurrentSlotIdx, int32, NewSlotIdx);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FHighlightIconDelegate, int32, SlotIdx, bool, bStartAnimation);
+
+/**
+ * Fixed number of item slots, with a bitmask of the free ones so finding a slot is a single bit scan.
+ * UI changes (equip, slot highlight) are only recorded while the frame runs. The component ticks once at the end of a
+ * frame that changed something and sends what's left, so toggling a highlight several times in a frame sends nothing
+ * or one event, never the whole sequence.
+ */
+UCLASS(ClassGroup = (Inventory), meta = (BlueprintSpawnableComponent))
+class PROJECTMARCUS_API UInventoryComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr int32 NumSlots = 6;
+	static_assert(NumSlots <= 32, "FreeSlots holds one bit per slot");
+
+	UInventoryComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// Puts Item in the first free slot and returns it, INDEX_NONE if the inventory is full
+	int32 AddItem(class AItemBase* Item);
+
+	// Replaces whatever is in Slot
+	void SetItem(int32 Slot, AItemBase* Item);
+
+	// Empties Slot and returns what was in it
+	AItemBase* RemoveItem(int32 Slot);
+
+	AItemBase* GetItem(int32 Slot) const { return IsValidSlot(Slot) ? Slots[Slot] : nullptr; }
+
+	static bool IsValidSlot(int32 Slot) { return Slot >= 0 && Slot < NumSlots; }
+
+	// INDEX_NONE when full
+	int32 GetFirstFreeSlot() const { return FreeSlots != 0 ? (int32)FMath::CountTrailingZeros(FreeSlots) : INDEX_NONE; }
+
+	bool IsFull() const { return FreeSlots == 0; }
+
+	int32 GetNumItems() const { return NumSlots - FPlatformMath::CountBits(FreeSlots); }
+
+	// Sent at the end of the frame, only the last highlight of the frame counts. INDEX_NONE unhighlights
+	void HighlightSlot(int32 Slot);
+
+	// Slot highlighted once this frame's changes are sent
+	int32 GetHighlightedSlot() const { return PendingHighlightedSlot; }
+
+	// Sent at the end of the frame as one change from the first old slot to the last new item's slot
+	void NotifyEquipped(int32 OldSlot, AItemBase* NewItem);
+
+	// Sends everything changed this frame now
+	void FlushNotifications();
+
+	FEquipItemDelegate& GetEquipItemDelegate() { return EquipItemDelegate; }
+	FHighlightIconDelegate& GetHighlightIconDelegate() { return HighlightIconDelegate; }
+
+protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	// Makes sure the end of frame tick runs
+	void MarkNotificationsDirty();
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory", meta = (AllowPrivateAccess = "true"))
+	TArray<AItemBase*> Slots;
+
+	// Bit per empty slot
+	uint32 FreeSlots = (1u << NumSlots) - 1;
+
+	// Sends slot info to inventory bar when equipping
+	UPROPERTY(BlueprintAssignable, Category = "Inventory", meta = (AllowPrivateAccess = "true"))
+	FEquipItemDelegate EquipItemDelegate;
+
+	// Sends which index in the inventory should be highlighted
+	UPROPERTY(BlueprintAssignable, Category = "Inventory", meta = (AllowPrivateAccess = "true"))
+	FHighlightIconDelegate HighlightIconDelegate;
+
+	// Highlighted slot the UI was last told about, and the one it should end the frame with
+	int32 HighlightedSlot = INDEX_NONE;
+	int32 PendingHighlightedSlot = INDEX_NONE;
+
+	// Equip change waiting for the end of the frame
+	bool bEquipPending = false;
+	int32 PendingEquipOldSlot = INDEX_NONE;
+	TWeakObjectPtr<AItemBase> PendingEquipItem;
+};
@@ -1,10 +1,71 @@
 
 #include "ProjectMarcus/PlayerController/ProjectMarcusPlayerController.h"
+#include "ProjectMarcus/Character/ProjectMarcusCharacter.h"
+#include "ProjectMarcus/UI/HUDMarkerComponent.h"
+#include "ProjectMarcus/UI/HUDOverlayWidget.h"
+#include "ProjectMarcus/UI/HUDViewModel.h"
 #include "Blueprint/UserWidget.h"
 
 AProjectMarcusPlayerController::AProjectMarcusPlayerController()
 {
+	HUDMarkers = CreateDefaultSubobject<UHUDMarkerComponent>(TEXT("HUDMarkers"));
+	HUDViewModel = CreateDefaultSubobject<UHUDViewModel>(TEXT("HUDViewModel"));
+}
+
+void AProjectMarcusPlayerController::UpdateCameraManager(float DeltaSeconds)
+{
+	Super::UpdateCameraManager(DeltaSeconds);
+
+	RefreshCrosshairViewRay();
+
+	// Markers project with the camera we just updated so they don't lag a frame behind
+	if (HUDMarkers)
+	{
+		HUDMarkers->UpdateMarkers();
+	}
+}
+
+const FCrosshairViewRay& AProjectMarcusPlayerController::GetCrosshairViewRay()
+{
+	if (!CrosshairViewRay.bValid)
+	{
+		RefreshCrosshairViewRay();
+	}
+	return CrosshairViewRay;
+}
 
+bool AProjectMarcusPlayerController::TraceFromCrosshairs(FHitResult& OutHitResult, FVector& OutHitLocation)
+{
+	return TraceFromCrosshairs(GetCrosshairViewRay(), OutHitResult, OutHitLocation);
+}
+
+bool AProjectMarcusPlayerController::TraceFromCrosshairs(const FCrosshairViewRay& Ray, FHitResult& OutHitResult, FVector& OutHitLocation)
+{
+	if (!Ray.bValid || GetWorld() == nullptr)
+	{
+		return false;
+	}
+
+	// Only ever reuse last frames trace (or this frames), anything older could have something new moving through it
+	const bool bCanReuseTrace = CachedTraceRay.bValid &&
+		GFrameCounter - CachedTraceRay.FrameNumber <= 1 &&
+		FVector::DistSquared(Ray.Origin, CachedTraceRay.Origin) <= FMath::Square(CrosshairTraceReuseDistance) &&
+		FVector::DotProduct(Ray.Direction, CachedTraceRay.Direction) >= FMath::Cos(FMath::DegreesToRadians(CrosshairTraceReuseAngle));
+
+	if (!bCanReuseTrace)
+	{
+		// 	Trace from crosshair pos in world outwards (in crosshair direction in world)
+		const FVector TraceStart = Ray.Origin;
+		const FVector TraceEnd = Ray.Origin + (Ray.Direction * TRACE_FAR);
+		GetWorld()->LineTraceSingleByChannel(CachedTraceHit, TraceStart, TraceEnd, ECollisionChannel::ECC_Visibility);
+		CachedTraceLocation = CachedTraceHit.bBlockingHit ? CachedTraceHit.Location : TraceEnd;
+		CachedTraceRay = Ray;
+		CachedTraceRay.FrameNumber = GFrameCounter;
+	}
+
+	OutHitResult = CachedTraceHit;
+	OutHitLocation = CachedTraceLocation;
+	return CachedTraceHit.bBlockingHit;
 }
 
 void AProjectMarcusPlayerController::BeginPlay()
@@ -15,7 +76,7 @@ void AProjectMarcusPlayerController::BeginPlay()
 	{
 		if (!HUDOverlay)
 		{
-			HUDOverlay = CreateWidget<UUserWidget>(this, HUDOverlayClass, TEXT("HUDOverlay"));
+			HUDOverlay = CreateWidget<UHUDOverlayWidget>(this, HUDOverlayClass, TEXT("HUDOverlay"));
 			if (HUDOverlay)
 			{
 				HUDOverlay->AddToViewport();
@@ -24,3 +85,40 @@ void AProjectMarcusPlayerController::BeginPlay()
 		}
 	}
 }
+
+void AProjectMarcusPlayerController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+
+	// The pawn may have begun play before it had a controller to push to
+	if (AProjectMarcusCharacter* PMCharacter = Cast<AProjectMarcusCharacter>(InPawn))
+	{
+		PMCharacter->RefreshHUDViewModel();
+	}
+}
+
+void AProjectMarcusPlayerController::RefreshCrosshairViewRay()
+{
+	// Get viewport size
+	int32 ViewportSizeX = 0;
+	int32 ViewportSizeY = 0;
+	GetViewportSize(ViewportSizeX, ViewportSizeY);
+
+	// Get screen space location of crosshairs
+	FVector2D CrosshairLocationOnScreen(ViewportSizeX / 2.f, ViewportSizeY / 2.f);
+	if (AProjectMarcusCharacter* PMCharacter = Cast<AProjectMarcusCharacter>(GetPawn()))
+	{
+		CrosshairLocationOnScreen.Y -= PMCharacter->GetCrosshairScreenOffset(); // need to match offset in HUD
+	}
+
+	// Get world location and direction of crosshairs
+	FVector WorldOrigin;
+	FVector WorldDirection;
+	if (DeprojectScreenPositionToWorld(CrosshairLocationOnScreen.X, CrosshairLocationOnScreen.Y, WorldOrigin, WorldDirection))
+	{
+		CrosshairViewRay.Origin = WorldOrigin;
+		CrosshairViewRay.Direction = WorldDirection;
+		CrosshairViewRay.bValid = true;
+		CrosshairViewRay.FrameNumber = GFrameCounter;
+	}
+}
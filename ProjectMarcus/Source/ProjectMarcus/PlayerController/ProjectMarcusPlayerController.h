@@ -6,6 +6,26 @@
 #include "GameFramework/PlayerController.h"
 #include "ProjectMarcusPlayerController.generated.h"
 
+// Where the crosshair points in the world for a single frame
+USTRUCT(BlueprintType)
+struct FCrosshairViewRay
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Crosshair")
+	FVector Origin = FVector::ZeroVector;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Crosshair")
+	FVector Direction = FVector::ForwardVector;
+
+	// False until the first successful deprojection
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Crosshair")
+	bool bValid = false;
+
+	// GFrameCounter when this ray was computed
+	uint64 FrameNumber = 0;
+};
+
 /**
  * 
  */
@@ -17,14 +37,67 @@ class PROJECTMARCUS_API AProjectMarcusPlayerController : public APlayerControlle
 public:
 	AProjectMarcusPlayerController();
 
+	// Called once per frame after all actors have ticked, refreshes the crosshair ray from the camera we just updated
+	virtual void UpdateCameraManager(float DeltaSeconds) override;
+
+	// Crosshair ray in world space shared by item focus, firing and the HUD (computed on demand if nothing is cached yet).
+	// It's refreshed in UpdateCameraManager, after every actor has ticked, so anything reading it from an actor or
+	// component tick gets the ray of the camera at the end of the previous frame (FrameNumber is GFrameCounter - 1).
+	// Code that needs this frame's camera has to run after the camera update, i.e. in TG_PostUpdateWork or called from
+	// UpdateCameraManager like the HUD markers. Tickable objects and subsystems tick before it and see last frame's camera
+	UFUNCTION(BlueprintCallable, Category = "Crosshair")
+	const FCrosshairViewRay& GetCrosshairViewRay();
+
+	// Line trace from crosshairs (in world space). OutHitResult contains a hit if one occurred. OutHitLocation contains the ending trace location whether it hit something or not.
+	// Reuses the previous frames trace if the camera moved less than the reuse epsilons since then.
+	// Traces along GetCrosshairViewRay, so during actor tick the hit is for the previous frame's camera
+	bool TraceFromCrosshairs(FHitResult& OutHitResult, FVector& OutHitLocation);
+
+	// Same as above along a given ray (e.g. one interpolated to a shot fired part way through the frame), sharing the same reuse cache
+	bool TraceFromCrosshairs(const FCrosshairViewRay& Ray, FHitResult& OutHitResult, FVector& OutHitLocation);
+
+	class UHUDMarkerComponent* GetHUDMarkers() const { return HUDMarkers; }
+
+	// Values the HUD overlay shows, pushed in by the possessed character
+	UFUNCTION(BlueprintPure, Category = "Widgets")
+	class UHUDViewModel* GetHUDViewModel() const { return HUDViewModel; }
+
 protected:
 	virtual void BeginPlay() override;
 
+	virtual void OnPossess(APawn* InPawn) override;
+
 private:
+	void RefreshCrosshairViewRay();
+
+	// Binds HUDViewModel on construct
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Widgets", meta = (AllowPrivateAccess = "true"))
-	TSubclassOf<class UUserWidget> HUDOverlayClass;
+	TSubclassOf<class UHUDOverlayWidget> HUDOverlayClass;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widgets", meta = (AllowPrivateAccess = "true"))
+	class UHUDOverlayWidget* HUDOverlay;
 
+	// Hit numbers and health bars anchored in the world
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widgets", meta = (AllowPrivateAccess = "true"))
-	class UUserWidget* HUDOverlay;
+	UHUDMarkerComponent* HUDMarkers;
+
+	// Created with the controller so it exists before the HUD widget and the pawn's BeginPlay
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widgets", meta = (AllowPrivateAccess = "true"))
+	UHUDViewModel* HUDViewModel;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Crosshair", meta = (AllowPrivateAccess = "true"))
+	FCrosshairViewRay CrosshairViewRay;
+
+	// Max distance the camera can move between frames and still reuse the last crosshair trace
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Crosshair", meta = (AllowPrivateAccess = "true"))
+	float CrosshairTraceReuseDistance = 1.f;
+
+	// Max angle (degrees) the camera can rotate between frames and still reuse the last crosshair trace
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Crosshair", meta = (AllowPrivateAccess = "true"))
+	float CrosshairTraceReuseAngle = 0.1f;
 
+	// Last crosshair trace and the ray it was taken along
+	FCrosshairViewRay CachedTraceRay;
+	FHitResult CachedTraceHit;
+	FVector CachedTraceLocation = FVector::ZeroVector;
 };
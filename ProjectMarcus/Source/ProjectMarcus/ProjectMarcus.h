@@ -3,4 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
 
+// All gameplay stats live under "stat ProjectMarcus"
+DECLARE_STATS_GROUP(TEXT("ProjectMarcus"), STATGROUP_ProjectMarcus, STATCAT_Advanced);
@@ -2,4 +2,15 @@
 
 
 #include "ProjectMarcusGameModeBase.h"
+#include "IAnimationBudgetAllocator.h"
 
+void AProjectMarcusGameModeBase::StartPlay()
+{
+	if (IAnimationBudgetAllocator* BudgetAllocator = IAnimationBudgetAllocator::Get(GetWorld()))
+	{
+		BudgetAllocator->SetParameters(AnimationBudget);
+		BudgetAllocator->SetEnabled(bEnableAnimationBudget);
+	}
+
+	Super::StartPlay();
+}
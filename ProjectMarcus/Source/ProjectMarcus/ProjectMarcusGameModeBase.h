@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
+#include "AnimationBudgetAllocatorParameters.h"
 #include "ProjectMarcusGameModeBase.generated.h"
 
 /**
@@ -13,5 +14,18 @@ UCLASS()
 class PROJECTMARCUS_API AProjectMarcusGameModeBase : public AGameModeBase
 {
 	GENERATED_BODY()
-	
+
+public:
+	// Sets up the animation budget before any actor begins play
+	virtual void StartPlay() override;
+
+	const FAnimationBudgetAllocatorParameters& GetAnimationBudget() const { return AnimationBudget; }
+
+private:
+	// Total anim update time per frame for budgeted meshes (enemies) and how quality drops once it's used up
+	UPROPERTY(EditDefaultsOnly, Category = "Animation Budget", meta = (AllowPrivateAccess = "true"))
+	FAnimationBudgetAllocatorParameters AnimationBudget;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Animation Budget", meta = (AllowPrivateAccess = "true"))
+	bool bEnableAnimationBudget = true;
 };
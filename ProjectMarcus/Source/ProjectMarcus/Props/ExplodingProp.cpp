@@ -1,14 +1,15 @@
 #include "ProjectMarcus/Props/ExplodingProp.h"
+#include "ProjectMarcus/Combat/DamageQueueSubsystem.h"
 
 #include "Kismet/GameplayStatics.h"
 #include "Sound/SoundCue.h"
-#include "Particles/ParticleSystemComponent.h"
+#include "Particles/ParticleSystem.h"
 
 // Sets default values
 AExplodingProp::AExplodingProp()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	// Nothing per frame, damage comes from the UDamageQueueSubsystem. Levels with lots of props should use AExplodingPropManager
+	PrimaryActorTick.bCanEverTick = false;
 
 }
 
@@ -17,24 +18,35 @@ void AExplodingProp::BeginPlay()
 {
 	Super::BeginPlay();
 	
+	if (UDamageQueueSubsystem* DamageQueue = GetWorld()->GetSubsystem<UDamageQueueSubsystem>())
+		DamageQueue->RegisterTarget(this, MaxHealth, MaxHealth);
 }
 
-// Called every frame
-void AExplodingProp::Tick(float DeltaTime)
+void AExplodingProp::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
+	if (UDamageQueueSubsystem* DamageQueue = GetWorld()->GetSubsystem<UDamageQueueSubsystem>())
+		DamageQueue->UnregisterTarget(this);
 
+	Super::EndPlay(EndPlayReason);
 }
 
-void AExplodingProp::OnBulletHit_Implementation(const FHitResult& HitResult)
+void AExplodingProp::OnDamageResolved(const FResolvedDamage& Damage)
 {
-	if (ExplodeSound)
-		UGameplayStatics::PlaySoundAtLocation(this, ExplodeSound, GetActorLocation());
-
-	if (ExplodeParticles)
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ExplodeParticles, HitResult.Location, FRotator(0.f), true);
-
-	// TODO: Damage in AOE
+	if (!Damage.bKilled)
+		return;
+
+	// Effects, damage and impulses all happen when the explosion gets its turn in the queue
+	if (UExplosionSubsystem* Explosions = GetWorld()->GetSubsystem<UExplosionSubsystem>())
+	{
+		UExplosionSubsystem::FExplosionRequest Request;
+		Request.Origin = GetActorLocation();
+		Request.Params = Explosion;
+		Request.Particles = ExplodeParticles;
+		Request.Sound = ExplodeSound;
+		Request.DamageCauser = this;
+		Request.Instigator = Damage.Instigator;
+		Explosions->QueueExplosion(Request);
+	}
 
 	Destroy();
 }
@@ -5,10 +5,12 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "ProjectMarcus/Interfaces/BulletHitInterface.h"
+#include "ProjectMarcus/Interfaces/DamageableInterface.h"
+#include "ProjectMarcus/Combat/ExplosionSubsystem.h"
 #include "ExplodingProp.generated.h"
 
 UCLASS()
-class PROJECTMARCUS_API AExplodingProp : public AActor, public IBulletHitInterface
+class PROJECTMARCUS_API AExplodingProp : public AActor, public IBulletHitInterface, public IDamageableInterface
 {
 	GENERATED_BODY()
 	
@@ -24,13 +26,21 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta= (AllowPrivateAccess = true))
 	class USoundCue* ExplodeSound;
 
+	// Explodes once this much damage has been dealt to it (any bullet by default)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta= (AllowPrivateAccess = true))
+	float MaxHealth = 1.f;
+
+	// Radial damage/impulse, goes through the UExplosionSubsystem so chains of props spread over frames
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta= (AllowPrivateAccess = true))
+	FExplosionParams Explosion;
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
-public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-	virtual void OnBulletHit_Implementation(const FHitResult& HitResult) override;
+public:	
+	// Explodes when killed
+	virtual void OnDamageResolved(const FResolvedDamage& Damage) override;
 };
@@ -0,0 +1,114 @@
+#include "ProjectMarcus/Props/ExplodingPropManager.h"
+#include "ProjectMarcus/Combat/DamageQueueSubsystem.h"
+
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Sound/SoundCue.h"
+#include "Particles/ParticleSystem.h"
+
+AExplodingPropManager::AExplodingPropManager()
+	: ExplodeParticles(nullptr)
+	, ExplodeSound(nullptr)
+{
+	// Nothing per frame, damage and explosions come from the subsystems
+	PrimaryActorTick.bCanEverTick = false;
+
+	Instances = CreateDefaultSubobject<UHierarchicalInstancedStaticMeshComponent>(TEXT("Instances"));
+	SetRootComponent(Instances);
+
+	// Blocks bullet traces and shows up in the explosion overlap (WorldDynamic)
+	Instances->SetCollisionProfileName(UCollisionProfile::BlockAllDynamic_ProfileName);
+}
+
+void AExplodingPropManager::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Instances placed in the level
+	InstanceProps.Reset(Instances->GetInstanceCount());
+	PropInstances.Reset();
+	for (int32 InstanceIndex = 0; InstanceIndex < Instances->GetInstanceCount(); ++InstanceIndex)
+	{
+		RegisterInstance(InstanceIndex);
+	}
+}
+
+void AExplodingPropManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UDamageQueueSubsystem* DamageQueue = GetWorld()->GetSubsystem<UDamageQueueSubsystem>())
+	{
+		for (const int32 PropId : InstanceProps)
+			DamageQueue->UnregisterTarget(this, PropId);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+int32 AExplodingPropManager::AddProp(const FTransform& WorldTransform)
+{
+	const int32 InstanceIndex = Instances->AddInstanceWorldSpace(WorldTransform);
+	return RegisterInstance(InstanceIndex);
+}
+
+int32 AExplodingPropManager::RegisterInstance(int32 InstanceIndex)
+{
+	const int32 PropId = NextPropId++;
+	check(InstanceIndex == InstanceProps.Num());
+	InstanceProps.Add(PropId);
+	PropInstances.Add(PropId, InstanceIndex);
+
+	if (UDamageQueueSubsystem* DamageQueue = GetWorld()->GetSubsystem<UDamageQueueSubsystem>())
+		DamageQueue->RegisterTarget(this, MaxHealth, MaxHealth, PropId);
+
+	return PropId;
+}
+
+void AExplodingPropManager::RemoveProp(int32 PropId)
+{
+	int32 InstanceIndex = INDEX_NONE;
+	if (!PropInstances.RemoveAndCopyValue(PropId, InstanceIndex))
+		return;
+
+	if (UDamageQueueSubsystem* DamageQueue = GetWorld()->GetSubsystem<UDamageQueueSubsystem>())
+		DamageQueue->UnregisterTarget(this, PropId);
+
+	// The HISM moves its last instance into the removed slot, mirror that
+	const int32 LastIndex = InstanceProps.Num() - 1;
+	if (InstanceIndex != LastIndex)
+		PropInstances[InstanceProps[LastIndex]] = InstanceIndex;
+	InstanceProps.RemoveAtSwap(InstanceIndex, 1, false);
+
+	Instances->RemoveInstance(InstanceIndex);
+}
+
+int32 AExplodingPropManager::GetDamageItem(const UPrimitiveComponent* Component, int32 ComponentItem) const
+{
+	if (Component != Instances || !InstanceProps.IsValidIndex(ComponentItem))
+		return INDEX_NONE;
+
+	return InstanceProps[ComponentItem];
+}
+
+void AExplodingPropManager::OnDamageResolved(const FResolvedDamage& Damage)
+{
+	const int32* InstanceIndex = PropInstances.Find(Damage.Item);
+	if (!Damage.bKilled || InstanceIndex == nullptr)
+		return;
+
+	FTransform InstanceTransform;
+	Instances->GetInstanceTransform(*InstanceIndex, InstanceTransform, true);
+
+	// Effects come from the pools when the explosion gets its turn in the queue
+	if (UExplosionSubsystem* Explosions = GetWorld()->GetSubsystem<UExplosionSubsystem>())
+	{
+		UExplosionSubsystem::FExplosionRequest Request;
+		Request.Origin = InstanceTransform.GetLocation();
+		Request.Params = Explosion;
+		Request.Particles = ExplodeParticles;
+		Request.Sound = ExplodeSound;
+		Request.Instigator = Damage.Instigator;
+		Explosions->QueueExplosion(Request);
+	}
+
+	RemoveProp(Damage.Item);
+}
@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "ProjectMarcus/Interfaces/DamageableInterface.h"
+#include "ProjectMarcus/Combat/ExplosionSubsystem.h"
+#include "ExplodingPropManager.generated.h"
+
+/**
+ * Every exploding prop of one type as instances of a single HISM, instead of an AExplodingProp actor each.
+ * Place the props as instances on the Instances component. Each instance is its own damageable (registered per item with
+ * the UDamageQueueSubsystem), a hit finds its instance through FHitResult::Item, and a destroyed prop just loses its
+ * instance. Doesn't tick.
+ */
+UCLASS()
+class PROJECTMARCUS_API AExplodingPropManager : public AActor, public IDamageableInterface
+{
+	GENERATED_BODY()
+
+public:
+	AExplodingPropManager();
+
+	// Adds a prop at a world transform, returns its id
+	int32 AddProp(const FTransform& WorldTransform);
+
+	// Removes the props instance, no explosion
+	void RemoveProp(int32 PropId);
+
+	int32 GetNumProps() const { return InstanceProps.Num(); }
+
+	virtual int32 GetDamageItem(const UPrimitiveComponent* Component, int32 ComponentItem) const override;
+
+	// Explodes the prop that was killed
+	virtual void OnDamageResolved(const FResolvedDamage& Damage) override;
+
+protected:
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	int32 RegisterInstance(int32 InstanceIndex);
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = true))
+	class UHierarchicalInstancedStaticMeshComponent* Instances;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
+	class UParticleSystem* ExplodeParticles;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
+	class USoundCue* ExplodeSound;
+
+	// Health of each prop
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
+	float MaxHealth = 1.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
+	FExplosionParams Explosion;
+
+	// Instance index -> prop id. The HISM removes instances with RemoveAtSwap, this does the same so the two stay in step
+	TArray<int32> InstanceProps;
+
+	// Prop id -> instance index
+	TMap<int32, int32> PropInstances;
+
+	int32 NextPropId = 0;
+};
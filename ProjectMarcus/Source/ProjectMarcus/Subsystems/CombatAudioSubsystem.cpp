@@ -0,0 +1,189 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Subsystems/CombatAudioSubsystem.h"
+#include "ProjectMarcus/ProjectMarcus.h"
+#include "Components/AudioComponent.h"
+#include "Sound/SoundBase.h"
+#include "GameFramework/WorldSettings.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Combat Audio Voices"), STAT_CombatAudioVoices, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Audio Steals"), STAT_CombatAudioSteals, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Audio Drops"), STAT_CombatAudioDrops, STATGROUP_ProjectMarcus);
+
+UCombatAudioSubsystem::UCombatAudioSubsystem()
+{
+	MaxVoicesPerCategory.Add(ECombatSoundCategory::ECSC_Weapon, 4);
+	MaxVoicesPerCategory.Add(ECombatSoundCategory::ECSC_Impact, 8);
+	MaxVoicesPerCategory.Add(ECombatSoundCategory::ECSC_Item, 4);
+	MaxVoicesPerCategory.Add(ECombatSoundCategory::ECSC_Explosion, 4);
+}
+
+void UCombatAudioSubsystem::Deinitialize()
+{
+	for (UAudioComponent* Component : AllComponents)
+	{
+		if (IsValid(Component))
+		{
+			Component->OnAudioFinishedNative.RemoveAll(this);
+			Component->DestroyComponent();
+		}
+	}
+	DEC_DWORD_STAT_BY(STAT_CombatAudioVoices, ActiveVoices.Num());
+	ActiveVoices.Empty();
+	FreeComponents.Empty();
+	AllComponents.Empty();
+	FMemory::Memzero(NumVoicesPerCategory);
+
+	Super::Deinitialize();
+}
+
+UAudioComponent* UCombatAudioSubsystem::PlaySound2D(USoundBase* Sound, ECombatSoundCategory Category, float Priority)
+{
+	return PlayVoice(Sound, nullptr, Category, Priority, false);
+}
+
+UAudioComponent* UCombatAudioSubsystem::PlaySoundAtLocation(USoundBase* Sound, const FVector& Location, ECombatSoundCategory Category, float Priority)
+{
+	return PlayVoice(Sound, &Location, Category, Priority, false);
+}
+
+UAudioComponent* UCombatAudioSubsystem::StartLoop2D(USoundBase* Sound, ECombatSoundCategory Category, float Priority)
+{
+	return PlayVoice(Sound, nullptr, Category, Priority, true);
+}
+
+void UCombatAudioSubsystem::StopLoop(UAudioComponent* LoopComponent, float FadeOutDuration)
+{
+	FCombatVoice* Voice = ActiveVoices.FindByPredicate([LoopComponent](const FCombatVoice& Entry) { return Entry.Component == LoopComponent; });
+	if (Voice == nullptr)
+	{
+		return;
+	}
+
+	// Fading voices can be stolen like any one shot, OnVoiceFinished returns it to the pool
+	Voice->bLooping = false;
+	if (FadeOutDuration > 0.f)
+	{
+		LoopComponent->FadeOut(FadeOutDuration, 0.f);
+	}
+	else
+	{
+		LoopComponent->Stop();
+	}
+}
+
+UAudioComponent* UCombatAudioSubsystem::PlayVoice(USoundBase* Sound, const FVector* Location, ECombatSoundCategory Category, float Priority, bool bLooping)
+{
+	if (Sound == nullptr || GetWorld() == nullptr || GetWorld()->GetNetMode() == NM_DedicatedServer || Category == ECombatSoundCategory::ECSC_Max)
+	{
+		return nullptr;
+	}
+
+	UAudioComponent* Component = AcquireComponent(Category, Priority);
+	if (Component == nullptr)
+	{
+		INC_DWORD_STAT(STAT_CombatAudioDrops);
+		return nullptr;
+	}
+
+	Component->bAllowSpatialization = Location != nullptr;
+	if (Location)
+	{
+		Component->SetWorldLocation(*Location);
+	}
+	Component->SetSound(Sound);
+	Component->Play();
+
+	FCombatVoice& Voice = ActiveVoices.AddDefaulted_GetRef();
+	Voice.Component = Component;
+	Voice.Category = Category;
+	Voice.Priority = Priority;
+	Voice.StartTime = GetWorld()->GetTimeSeconds();
+	Voice.bLooping = bLooping;
+	++NumVoicesPerCategory[(int32)Category];
+	INC_DWORD_STAT(STAT_CombatAudioVoices);
+
+	return Component;
+}
+
+UAudioComponent* UCombatAudioSubsystem::AcquireComponent(ECombatSoundCategory Category, float Priority)
+{
+	if (NumVoicesPerCategory[(int32)Category] < GetMaxVoices(Category))
+	{
+		return FreeComponents.Num() > 0 ? FreeComponents.Pop(false) : CreateComponent();
+	}
+
+	// Category is full, look for the lowest priority (then oldest) one shot to steal
+	int32 StealIdx = INDEX_NONE;
+	for (int32 Idx = 0; Idx < ActiveVoices.Num(); ++Idx)
+	{
+		const FCombatVoice& Voice = ActiveVoices[Idx];
+		if (Voice.Category != Category || Voice.bLooping || Voice.Priority > Priority)
+		{
+			continue;
+		}
+
+		if (StealIdx == INDEX_NONE ||
+			Voice.Priority < ActiveVoices[StealIdx].Priority ||
+			(Voice.Priority == ActiveVoices[StealIdx].Priority && Voice.StartTime < ActiveVoices[StealIdx].StartTime))
+		{
+			StealIdx = Idx;
+		}
+	}
+
+	if (StealIdx == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	// Take it out of the active list before stopping so OnVoiceFinished doesn't also put it in the free list
+	UAudioComponent* Component = ActiveVoices[StealIdx].Component;
+	ActiveVoices.RemoveAtSwap(StealIdx, 1, false);
+	--NumVoicesPerCategory[(int32)Category];
+	DEC_DWORD_STAT(STAT_CombatAudioVoices);
+
+	Component->Stop();
+	INC_DWORD_STAT(STAT_CombatAudioSteals);
+	return Component;
+}
+
+UAudioComponent* UCombatAudioSubsystem::CreateComponent()
+{
+	// Owned by the world settings actor so the components live as long as the world does
+	AWorldSettings* WorldSettings = GetWorld()->GetWorldSettings();
+	if (WorldSettings == nullptr)
+	{
+		return nullptr;
+	}
+
+	UAudioComponent* Component = NewObject<UAudioComponent>(WorldSettings);
+	Component->bAutoActivate = false;
+	Component->bAutoDestroy = false;
+	Component->bStopWhenOwnerDestroyed = false;
+	Component->SetAbsolute(true, true, true);
+	Component->OnAudioFinishedNative.AddUObject(this, &UCombatAudioSubsystem::OnVoiceFinished);
+	Component->RegisterComponentWithWorld(GetWorld());
+
+	AllComponents.Add(Component);
+	return Component;
+}
+
+void UCombatAudioSubsystem::OnVoiceFinished(UAudioComponent* Component)
+{
+	const int32 VoiceIdx = ActiveVoices.IndexOfByPredicate([Component](const FCombatVoice& Voice) { return Voice.Component == Component; });
+	if (VoiceIdx == INDEX_NONE)
+	{
+		return;
+	}
+
+	--NumVoicesPerCategory[(int32)ActiveVoices[VoiceIdx].Category];
+	ActiveVoices.RemoveAtSwap(VoiceIdx, 1, false);
+	FreeComponents.Add(Component);
+	DEC_DWORD_STAT(STAT_CombatAudioVoices);
+}
+
+int32 UCombatAudioSubsystem::GetMaxVoices(ECombatSoundCategory Category) const
+{
+	const int32* MaxVoices = MaxVoicesPerCategory.Find(Category);
+	return FMath::Max(MaxVoices ? *MaxVoices : DefaultMaxVoices, 1);
+}
@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatAudioSubsystem.generated.h"
+
+UENUM(BlueprintType)
+enum class ECombatSoundCategory : uint8
+{
+	ECSC_Weapon UMETA(DisplayName = "Weapon"),
+	ECSC_Impact UMETA(DisplayName = "Impact"),
+	ECSC_Item UMETA(DisplayName = "Item"),
+	ECSC_Explosion UMETA(DisplayName = "Explosion"),
+	ECSC_Max UMETA(DisplayName = "InvalidMAX")
+};
+
+/**
+ * Plays combat sounds on a pool of audio components owned by the world.
+ * Every category has a voice limit. When a category is full the new sound steals the lowest priority (then oldest)
+ * one shot in that category, or is dropped if everything playing outranks it. Loops are never stolen.
+ */
+UCLASS(Config = Game)
+class PROJECTMARCUS_API UCombatAudioSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UCombatAudioSubsystem();
+
+	virtual void Deinitialize() override;
+
+	// One shot sounds. Return nullptr if the sound was dropped. Don't hold on to the component, it goes back to the pool when it finishes
+	class UAudioComponent* PlaySound2D(class USoundBase* Sound, ECombatSoundCategory Category, float Priority = 1.f);
+	UAudioComponent* PlaySoundAtLocation(USoundBase* Sound, const FVector& Location, ECombatSoundCategory Category, float Priority = 1.f);
+
+	// Starts a looping 2D voice (Sound must loop) that plays until StopLoop
+	UAudioComponent* StartLoop2D(USoundBase* Sound, ECombatSoundCategory Category, float Priority = 1.f);
+	void StopLoop(UAudioComponent* LoopComponent, float FadeOutDuration = 0.f);
+
+private:
+	struct FCombatVoice
+	{
+		UAudioComponent* Component = nullptr;
+		ECombatSoundCategory Category = ECombatSoundCategory::ECSC_Max;
+		float Priority = 0.f;
+		double StartTime = 0.0;
+		bool bLooping = false;
+	};
+
+	UAudioComponent* PlayVoice(USoundBase* Sound, const FVector* Location, ECombatSoundCategory Category, float Priority, bool bLooping);
+
+	// Finds a free component for the category, stealing a voice if the category is full. nullptr means drop
+	UAudioComponent* AcquireComponent(ECombatSoundCategory Category, float Priority);
+
+	UAudioComponent* CreateComponent();
+
+	void OnVoiceFinished(UAudioComponent* Component);
+
+	int32 GetMaxVoices(ECombatSoundCategory Category) const;
+
+	// Categories not listed fall back to DefaultMaxVoices
+	UPROPERTY(Config)
+	TMap<ECombatSoundCategory, int32> MaxVoicesPerCategory;
+
+	UPROPERTY(Config)
+	int32 DefaultMaxVoices = 4;
+
+	// Components not playing anything
+	UPROPERTY(Transient)
+	TArray<UAudioComponent*> FreeComponents;
+
+	// Keeps every component alive, playing or not
+	UPROPERTY(Transient)
+	TArray<UAudioComponent*> AllComponents;
+
+	TArray<FCombatVoice> ActiveVoices;
+
+	int32 NumVoicesPerCategory[(int32)ECombatSoundCategory::ECSC_Max] = {};
+};
@@ -0,0 +1,145 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Subsystems/EmitterPoolSubsystem.h"
+#include "ProjectMarcus/ProjectMarcus.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "GameFramework/WorldSettings.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Emitter Pool Spawns"), STAT_EmitterPoolSpawns, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Emitter Pool Reuses"), STAT_EmitterPoolReuses, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Emitter Pool Drops"), STAT_EmitterPoolDrops, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Emitters"), STAT_PooledEmitters, STATGROUP_ProjectMarcus);
+
+void UEmitterPoolSubsystem::Deinitialize()
+{
+	for (auto& Pool : Pools)
+	{
+		DEC_DWORD_STAT_BY(STAT_PooledEmitters, Pool.Value.Free.Num() + Pool.Value.Active.Num());
+		for (UParticleSystemComponent* Component : Pool.Value.Free)
+		{
+			if (IsValid(Component))
+			{
+				Component->DestroyComponent();
+			}
+		}
+		for (UParticleSystemComponent* Component : Pool.Value.Active)
+		{
+			if (IsValid(Component))
+			{
+				Component->DestroyComponent();
+			}
+		}
+	}
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
+
+UParticleSystemComponent* UEmitterPoolSubsystem::SpawnEmitter(UParticleSystem* Template, const FTransform& Transform)
+{
+	if (Template == nullptr || GetWorld() == nullptr || GetWorld()->GetNetMode() == NM_DedicatedServer)
+	{
+		return nullptr;
+	}
+
+	FEmitterPool& Pool = GetPool(Template);
+
+	UParticleSystemComponent* Component = nullptr;
+	if (Pool.Free.Num() > 0)
+	{
+		Component = Pool.Free.Pop(false);
+		INC_DWORD_STAT(STAT_EmitterPoolReuses);
+	}
+	else if (Pool.Active.Num() < Pool.MaxComponents)
+	{
+		Component = CreateComponent(Template);
+		INC_DWORD_STAT(STAT_EmitterPoolSpawns);
+	}
+	else if (Pool.Active.Num() > 0)
+	{
+		// Restarting something that only started this frame would just swap one effect for another, drop the new one instead
+		if (Pool.ActiveSpawnFrames[0] == GFrameCounter)
+		{
+			INC_DWORD_STAT(STAT_EmitterPoolDrops);
+			return nullptr;
+		}
+
+		// Recycle the oldest
+		Component = Pool.Active[0];
+		Pool.Active.RemoveAt(0, 1, false);
+		Pool.ActiveSpawnFrames.RemoveAt(0, 1, false);
+		Component->DeactivateImmediate();
+		INC_DWORD_STAT(STAT_EmitterPoolReuses);
+	}
+
+	if (Component == nullptr)
+	{
+		INC_DWORD_STAT(STAT_EmitterPoolDrops);
+		return nullptr;
+	}
+
+	Component->SetWorldTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	Component->ActivateSystem(true);
+
+	Pool.Active.Add(Component);
+	Pool.ActiveSpawnFrames.Add(GFrameCounter);
+	return Component;
+}
+
+void UEmitterPoolSubsystem::OnEmitterFinished(UParticleSystemComponent* Component)
+{
+	if (Component == nullptr)
+	{
+		return;
+	}
+
+	FEmitterPool* Pool = Pools.Find(Component->Template);
+	if (Pool == nullptr)
+	{
+		return;
+	}
+
+	const int32 ActiveIdx = Pool->Active.Find(Component);
+	if (ActiveIdx != INDEX_NONE)
+	{
+		// Keep oldest-first order
+		Pool->Active.RemoveAt(ActiveIdx, 1, false);
+		Pool->ActiveSpawnFrames.RemoveAt(ActiveIdx, 1, false);
+		Pool->Free.Add(Component);
+	}
+}
+
+FEmitterPool& UEmitterPoolSubsystem::GetPool(UParticleSystem* Template)
+{
+	if (FEmitterPool* Pool = Pools.Find(Template))
+	{
+		return *Pool;
+	}
+
+	FEmitterPool& Pool = Pools.Add(Template);
+	const int32* Cap = SystemCaps.Find(FSoftObjectPath(Template));
+	Pool.MaxComponents = FMath::Max(Cap ? *Cap : DefaultMaxPerSystem, 1);
+	return Pool;
+}
+
+UParticleSystemComponent* UEmitterPoolSubsystem::CreateComponent(UParticleSystem* Template)
+{
+	// Owned by the world settings actor so the components live as long as the world does
+	AWorldSettings* WorldSettings = GetWorld()->GetWorldSettings();
+	if (WorldSettings == nullptr)
+	{
+		return nullptr;
+	}
+
+	UParticleSystemComponent* Component = NewObject<UParticleSystemComponent>(WorldSettings);
+	Component->bAutoActivate = false;
+	Component->bAutoDestroy = false;
+	Component->SetAbsolute(true, true, true);
+	Component->SetTemplate(Template);
+	Component->OnSystemFinished.AddDynamic(this, &UEmitterPoolSubsystem::OnEmitterFinished);
+	Component->RegisterComponentWithWorld(GetWorld());
+
+	INC_DWORD_STAT(STAT_PooledEmitters);
+	return Component;
+}
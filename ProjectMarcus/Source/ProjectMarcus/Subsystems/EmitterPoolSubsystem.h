@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EmitterPoolSubsystem.generated.h"
+
+USTRUCT()
+struct FEmitterPool
+{
+	GENERATED_BODY()
+
+	// Finished components ready to be reused
+	UPROPERTY()
+	TArray<class UParticleSystemComponent*> Free;
+
+	// Playing components, oldest first
+	UPROPERTY()
+	TArray<UParticleSystemComponent*> Active;
+
+	// Frame each Active component was (re)started on, parallel to Active
+	TArray<uint64> ActiveSpawnFrames;
+
+	int32 MaxComponents = 0;
+};
+
+/**
+ * World level pool of particle components, one pool per UParticleSystem.
+ * Each system is capped. Once a system hits its cap the oldest playing component is restarted at the new location,
+ * and if even that one only started this frame the spawn is dropped.
+ */
+UCLASS(Config = Game)
+class PROJECTMARCUS_API UEmitterPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Plays Template at Transform. Returns nullptr if the spawn was dropped. Don't hold on to the component, it goes back to the pool when it finishes
+	UParticleSystemComponent* SpawnEmitter(class UParticleSystem* Template, const FTransform& Transform);
+
+	UParticleSystemComponent* SpawnEmitter(UParticleSystem* Template, const FVector& Location, const FRotator& Rotation = FRotator::ZeroRotator)
+	{
+		return SpawnEmitter(Template, FTransform(Rotation, Location));
+	}
+
+private:
+	UFUNCTION()
+	void OnEmitterFinished(UParticleSystemComponent* Component);
+
+	FEmitterPool& GetPool(UParticleSystem* Template);
+
+	UParticleSystemComponent* CreateComponent(UParticleSystem* Template);
+
+	// Cap for systems not listed in SystemCaps
+	UPROPERTY(Config)
+	int32 DefaultMaxPerSystem = 32;
+
+	// Per system caps, e.g. +SystemCaps=(("/Game/FX/P_MuzzleFlash.P_MuzzleFlash", 16))
+	UPROPERTY(Config)
+	TMap<FSoftObjectPath, int32> SystemCaps;
+
+	UPROPERTY()
+	TMap<UParticleSystem*, FEmitterPool> Pools;
+};
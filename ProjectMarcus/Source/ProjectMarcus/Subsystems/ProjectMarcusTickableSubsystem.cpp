@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Subsystems/ProjectMarcusTickableSubsystem.h"
+
+void UProjectMarcusTickableSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	bInitialized = true;
+}
+
+void UProjectMarcusTickableSubsystem::Deinitialize()
+{
+	bInitialized = false;
+	Super::Deinitialize();
+}
+
+ETickableTickType UProjectMarcusTickableSubsystem::GetTickableTickType() const
+{
+	// The CDO gets registered as a tickable too, never tick it
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UProjectMarcusTickableSubsystem::IsTickable() const
+{
+	const UWorld* World = GetWorld();
+	return bInitialized && World && World->IsGameWorld();
+}
+
+TStatId UProjectMarcusTickableSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UProjectMarcusTickableSubsystem, STATGROUP_Tickables);
+}
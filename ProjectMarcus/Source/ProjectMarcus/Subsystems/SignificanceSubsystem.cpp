@@ -0,0 +1,247 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Subsystems/SignificanceSubsystem.h"
+#include "ProjectMarcus/ProjectMarcus.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Significance Rescore"), STAT_SignificanceRescore, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Significance Actors Rescored"), STAT_SignificanceRescored, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Significance High"), STAT_SignificanceHigh, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Significance Medium"), STAT_SignificanceMedium, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Significance Low"), STAT_SignificanceLow, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Significance Dormant"), STAT_SignificanceDormant, STATGROUP_ProjectMarcus);
+DECLARE_CYCLE_STAT(TEXT("Tick High Significance"), STAT_TickHighSignificance, STATGROUP_ProjectMarcus);
+DECLARE_CYCLE_STAT(TEXT("Tick Medium Significance"), STAT_TickMediumSignificance, STATGROUP_ProjectMarcus);
+DECLARE_CYCLE_STAT(TEXT("Tick Low Significance"), STAT_TickLowSignificance, STATGROUP_ProjectMarcus);
+
+void USignificanceSubsystem::Deinitialize()
+{
+	Actors.Empty();
+	ActorIds.Empty();
+	Significants.Empty();
+	MaxDistances.Empty();
+	Buckets.Empty();
+	ActorIndices.Empty();
+
+	for (int32& Count : BucketCounts)
+	{
+		Count = 0;
+	}
+
+	Super::Deinitialize();
+}
+
+void USignificanceSubsystem::RegisterActor(AActor* Actor, float MaxDistance)
+{
+	ISignificanceInterface* Significant = Cast<ISignificanceInterface>(Actor);
+	if (Significant == nullptr || ActorIndices.Contains(Actor->GetUniqueID()))
+	{
+		return;
+	}
+
+	const int32 Index = Actors.Add(Actor);
+	ActorIds.Add(Actor->GetUniqueID());
+	Significants.Add(Significant);
+	MaxDistances.Add(MaxDistance > 0.f ? MaxDistance : DefaultMaxDistance);
+	Buckets.Add(ESignificanceBucket::ESB_High);
+	ActorIndices.Add(Actor->GetUniqueID(), Index);
+	++BucketCounts[(int32)ESignificanceBucket::ESB_High];
+
+	// Start out in the right bucket instead of ticking at full rate until its turn comes
+	RescoreActor(Actor);
+}
+
+void USignificanceSubsystem::UnregisterActor(AActor* Actor)
+{
+	int32 Index = INDEX_NONE;
+	if (Actor && ActorIndices.RemoveAndCopyValue(Actor->GetUniqueID(), Index))
+	{
+		RemoveActorAt(Index);
+	}
+}
+
+void USignificanceSubsystem::RescoreActor(AActor* Actor)
+{
+	const int32* Index = Actor ? ActorIndices.Find(Actor->GetUniqueID()) : nullptr;
+	FVector ViewLocation;
+	if (Index && GetViewLocation(ViewLocation))
+	{
+		Rescore(*Index, ViewLocation);
+	}
+}
+
+ESignificanceBucket USignificanceSubsystem::GetBucket(const AActor* Actor) const
+{
+	const int32* Index = Actor ? ActorIndices.Find(Actor->GetUniqueID()) : nullptr;
+	return Index ? Buckets[*Index] : ESignificanceBucket::ESB_High;
+}
+
+float USignificanceSubsystem::GetTickInterval(ESignificanceBucket Bucket) const
+{
+	switch (Bucket)
+	{
+	case ESignificanceBucket::ESB_Medium:
+		return MediumTickInterval;
+	case ESignificanceBucket::ESB_Low:
+	case ESignificanceBucket::ESB_Dormant:
+		return LowTickInterval;
+	default:
+		return 0.f;
+	}
+}
+
+TStatId USignificanceSubsystem::GetBucketTickStatId(ESignificanceBucket Bucket)
+{
+	switch (Bucket)
+	{
+	case ESignificanceBucket::ESB_Medium:
+		return GET_STATID(STAT_TickMediumSignificance);
+	case ESignificanceBucket::ESB_Low:
+	case ESignificanceBucket::ESB_Dormant:
+		return GET_STATID(STAT_TickLowSignificance);
+	default:
+		return GET_STATID(STAT_TickHighSignificance);
+	}
+}
+
+void USignificanceSubsystem::Tick(float DeltaTime)
+{
+	if (Actors.Num() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_SignificanceRescore);
+
+	FVector ViewLocation;
+	if (!GetViewLocation(ViewLocation))
+	{
+		return;
+	}
+
+	// This frames share of a full pass, fractions carry over so small counts still get rescored on time
+	RescoreCredit = FMath::Min(RescoreCredit + Actors.Num() * DeltaTime / FMath::Max(RescoreInterval, KINDA_SMALL_NUMBER), (float)Actors.Num());
+	const int32 NumToRescore = FMath::FloorToInt(RescoreCredit);
+	RescoreCredit -= NumToRescore;
+
+	for (int32 Rescored = 0; Rescored < NumToRescore; ++Rescored)
+	{
+		if (RescoreCursor >= Actors.Num())
+		{
+			RescoreCursor = 0;
+		}
+		Rescore(RescoreCursor++, ViewLocation);
+	}
+
+	INC_DWORD_STAT_BY(STAT_SignificanceRescored, NumToRescore);
+	SET_DWORD_STAT(STAT_SignificanceHigh, BucketCounts[(int32)ESignificanceBucket::ESB_High]);
+	SET_DWORD_STAT(STAT_SignificanceMedium, BucketCounts[(int32)ESignificanceBucket::ESB_Medium]);
+	SET_DWORD_STAT(STAT_SignificanceLow, BucketCounts[(int32)ESignificanceBucket::ESB_Low]);
+	SET_DWORD_STAT(STAT_SignificanceDormant, BucketCounts[(int32)ESignificanceBucket::ESB_Dormant]);
+}
+
+TStatId USignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USignificanceSubsystem, STATGROUP_Tickables);
+}
+
+bool USignificanceSubsystem::GetViewLocation(FVector& OutViewLocation) const
+{
+	const UWorld* World = GetWorld();
+	const APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+	if (PC == nullptr || PC->PlayerCameraManager == nullptr)
+	{
+		return false;
+	}
+
+	OutViewLocation = PC->PlayerCameraManager->GetCameraLocation();
+	return true;
+}
+
+void USignificanceSubsystem::Rescore(int32 Index, const FVector& ViewLocation)
+{
+	const AActor* Actor = Actors[Index].Get();
+	ISignificanceInterface* Significant = Significants[Index];
+	if (Actor == nullptr || Significant == nullptr)
+	{
+		return;
+	}
+
+	float Significance = 1.f;
+	if (!Significant->IsAlwaysSignificant())
+	{
+		const float Distance = FVector::Dist(Actor->GetActorLocation(), ViewLocation);
+		const float DistanceScale = 1.f - FMath::Min(Distance / MaxDistances[Index], 1.f);
+		const float RenderedScale = Actor->WasRecentlyRendered(RenderedTolerance) ? 1.f : NotRenderedScale;
+		Significance = DistanceScale * RenderedScale * Significant->GetSignificanceStateScale();
+	}
+
+	const ESignificanceBucket Bucket = GetBucketForSignificance(Significance);
+	if (Bucket != Buckets[Index])
+	{
+		--BucketCounts[(int32)Buckets[Index]];
+		++BucketCounts[(int32)Bucket];
+		Buckets[Index] = Bucket;
+	}
+
+	Significant->OnSignificanceUpdated(Significance, Bucket, GetTickInterval(Bucket));
+}
+
+ESignificanceBucket USignificanceSubsystem::GetBucketForSignificance(float Significance) const
+{
+	if (Significance >= HighMinSignificance)
+	{
+		return ESignificanceBucket::ESB_High;
+	}
+	if (Significance >= MediumMinSignificance)
+	{
+		return ESignificanceBucket::ESB_Medium;
+	}
+	if (Significance >= LowMinSignificance)
+	{
+		return ESignificanceBucket::ESB_Low;
+	}
+	return ESignificanceBucket::ESB_Dormant;
+}
+
+void USignificanceSubsystem::RemoveActorAt(int32 Index)
+{
+	--BucketCounts[(int32)Buckets[Index]];
+
+	// The last actor moves into the hole
+	const int32 LastIndex = Actors.Num() - 1;
+	if (Index != LastIndex)
+	{
+		ActorIndices.Add(ActorIds[LastIndex], Index);
+	}
+
+	Actors.RemoveAtSwap(Index, 1, false);
+	ActorIds.RemoveAtSwap(Index, 1, false);
+	Significants.RemoveAtSwap(Index, 1, false);
+	MaxDistances.RemoveAtSwap(Index, 1, false);
+	Buckets.RemoveAtSwap(Index, 1, false);
+
+	// The last actor hasn't been rescored this pass but may have landed behind the cursor. Swap it with the last actor
+	// that has been and step the cursor back onto it, so nothing is skipped or rescored twice
+	if (Index < RescoreCursor)
+	{
+		--RescoreCursor;
+		if (RescoreCursor < Actors.Num() && Index != RescoreCursor)
+		{
+			SwapActors(Index, RescoreCursor);
+		}
+	}
+}
+
+void USignificanceSubsystem::SwapActors(int32 IndexA, int32 IndexB)
+{
+	Actors.Swap(IndexA, IndexB);
+	ActorIds.Swap(IndexA, IndexB);
+	Significants.Swap(IndexA, IndexB);
+	MaxDistances.Swap(IndexA, IndexB);
+	Buckets.Swap(IndexA, IndexB);
+
+	ActorIndices.Add(ActorIds[IndexA], IndexA);
+	ActorIndices.Add(ActorIds[IndexB], IndexB);
+}
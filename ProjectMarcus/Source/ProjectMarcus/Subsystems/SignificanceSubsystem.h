@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProjectMarcus/Subsystems/ProjectMarcusTickableSubsystem.h"
+#include "ProjectMarcus/Interfaces/SignificanceInterface.h"
+#include "SignificanceSubsystem.generated.h"
+
+/**
+ * Scores every registered gameplay actor (items, enemies) by distance to the camera, whether it was rendered recently
+ * (off screen and occluded count the same) and its own state, and sorts it into a tick bucket. High ticks every frame, Medium and Low at their intervals, Dormant not at all.
+ * Rescoring is time sliced: each frame only does its share so every actor is rescored once per RescoreInterval.
+ */
+UCLASS(Config = Game)
+class PROJECTMARCUS_API USignificanceSubsystem : public UProjectMarcusTickableSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Actor must implement ISignificanceInterface. MaxDistance is where its score reaches 0, <= 0 uses DefaultMaxDistance
+	void RegisterActor(AActor* Actor, float MaxDistance = 0.f);
+
+	void UnregisterActor(AActor* Actor);
+
+	// Rescores Actor right away instead of waiting for its turn (e.g. its state changed)
+	void RescoreActor(AActor* Actor);
+
+	ESignificanceBucket GetBucket(const AActor* Actor) const;
+
+	float GetTickInterval(ESignificanceBucket Bucket) const;
+
+	// Cycle stat for actor ticks in a bucket, so per bucket tick time shows up in stat ProjectMarcus
+	static TStatId GetBucketTickStatId(ESignificanceBucket Bucket);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	// Camera of the first local player, false if there isn't one
+	bool GetViewLocation(FVector& OutViewLocation) const;
+
+	void Rescore(int32 Index, const FVector& ViewLocation);
+
+	ESignificanceBucket GetBucketForSignificance(float Significance) const;
+
+	void RemoveActorAt(int32 Index);
+
+	// Swaps two entries of the parallel arrays
+	void SwapActors(int32 IndexA, int32 IndexB);
+
+	// Seconds for one full pass over every registered actor
+	UPROPERTY(Config)
+	float RescoreInterval = 0.25f;
+
+	UPROPERTY(Config)
+	float DefaultMaxDistance = 5000.f;
+
+	// Seconds since an actor was last rendered for it to still count as visible
+	UPROPERTY(Config)
+	float RenderedTolerance = 0.2f;
+
+	// Score multiplier for actors that weren't rendered recently
+	UPROPERTY(Config)
+	float NotRenderedScale = 0.35f;
+
+	// Lowest score for each bucket, anything under LowMinSignificance is dormant
+	UPROPERTY(Config)
+	float HighMinSignificance = 0.6f;
+
+	UPROPERTY(Config)
+	float MediumMinSignificance = 0.3f;
+
+	UPROPERTY(Config)
+	float LowMinSignificance = 0.05f;
+
+	// High ticks every frame
+	UPROPERTY(Config)
+	float MediumTickInterval = 0.1f;
+
+	UPROPERTY(Config)
+	float LowTickInterval = 0.3f;
+
+	// Parallel arrays, one entry per registered actor
+	TArray<TWeakObjectPtr<AActor>> Actors;
+	TArray<uint32> ActorIds;
+	TArray<ISignificanceInterface*> Significants;
+	TArray<float> MaxDistances;
+	TArray<ESignificanceBucket> Buckets;
+
+	// Actor unique id -> index
+	TMap<uint32, int32> ActorIndices;
+
+	int32 BucketCounts[(int32)ESignificanceBucket::ESB_Max] = {};
+
+	// Next actor to rescore, and how many rescores this frame has earned but not done yet
+	int32 RescoreCursor = 0;
+	float RescoreCredit = 0.f;
+};
@@ -0,0 +1,246 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Subsystems/SpawnQueueSubsystem.h"
+#include "ProjectMarcus/Interactables/ItemBase.h"
+#include "ProjectMarcus/Interactables/ItemPoolSubsystem.h"
+#include "ProjectMarcus/ProjectMarcus.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+
+DECLARE_CYCLE_STAT(TEXT("Spawn Queue"), STAT_SpawnQueue, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Queued Spawns"), STAT_QueuedSpawns, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Queued Spawns Finished"), STAT_QueuedSpawnsFinished, STATGROUP_ProjectMarcus);
+
+static FAutoConsoleCommandWithWorldAndArgs SpawnQueueBenchmarkCommand(
+	TEXT("ProjectMarcus.SpawnQueueBenchmark"),
+	TEXT("Queues Count (default 500) spawns of ClassPath in front of the player and logs the worst frame once they're all live. ProjectMarcus.SpawnQueueBenchmark ClassPath [Count]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&USpawnQueueSubsystem::RunBenchmark));
+
+void USpawnQueueSubsystem::Deinitialize()
+{
+	// Deferred actors go down with the world
+	for (TArray<FQueuedSpawn>& Queue : Queues)
+	{
+		Queue.Empty();
+	}
+	SET_DWORD_STAT(STAT_QueuedSpawns, 0);
+	bBenchmarkRunning = false;
+
+	Super::Deinitialize();
+}
+
+uint32 USpawnQueueSubsystem::QueueSpawn(TSubclassOf<AActor> ActorClass, const FTransform& Transform, ESpawnPriority Priority, FOnQueuedSpawnFinished OnFinished, ESpawnActorCollisionHandlingMethod CollisionHandling)
+{
+	if (ActorClass == nullptr || Priority >= ESpawnPriority::ESP_Max)
+	{
+		return 0;
+	}
+
+	FQueuedSpawn& Spawn = Queues[(int32)Priority].AddDefaulted_GetRef();
+	Spawn.Id = NextSpawnId++;
+	Spawn.ActorClass = ActorClass;
+	Spawn.Transform = Transform;
+	Spawn.CollisionHandling = CollisionHandling;
+	Spawn.OnFinished = MoveTemp(OnFinished);
+	INC_DWORD_STAT(STAT_QueuedSpawns);
+
+	// 0 is never handed out
+	if (NextSpawnId == 0)
+	{
+		NextSpawnId = 1;
+	}
+	return Spawn.Id;
+}
+
+bool USpawnQueueSubsystem::CancelSpawn(uint32 SpawnId)
+{
+	for (TArray<FQueuedSpawn>& Queue : Queues)
+	{
+		for (FQueuedSpawn& Spawn : Queue)
+		{
+			if (Spawn.Id == SpawnId && Spawn.ActorClass)
+			{
+				// Left in place and skipped by the next step, the queue may be mid way through a tick
+				if (AActor* DeferredActor = Spawn.DeferredActor.Get())
+				{
+					DeferredActor->Destroy();
+				}
+				Spawn.ActorClass = nullptr;
+				Spawn.DeferredActor.Reset();
+				Spawn.OnFinished.Unbind();
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+int32 USpawnQueueSubsystem::GetNumQueued() const
+{
+	int32 NumQueued = 0;
+	for (const TArray<FQueuedSpawn>& Queue : Queues)
+	{
+		NumQueued += Queue.Num();
+	}
+	return NumQueued;
+}
+
+void USpawnQueueSubsystem::Tick(float DeltaTime)
+{
+	if (bBenchmarkRunning)
+	{
+		// Tick to tick is one whole frame, the one the last tick's spawns landed in. DeltaTime is a frame behind that
+		const double Now = FPlatformTime::Seconds();
+		if (BenchmarkLastTickTime > 0.0)
+		{
+			BenchmarkWorstFrameMs = FMath::Max(BenchmarkWorstFrameMs, (float)((Now - BenchmarkLastTickTime) * 1000.0));
+		}
+		BenchmarkLastTickTime = Now;
+
+		// The frame that finished the last spawns has been measured
+		if (GetNumQueued() == 0)
+		{
+			UE_LOG(LogTemp, Log, TEXT("USpawnQueueSubsystem, benchmark spawned %d actors over %d frames. Worst frame %.2f ms, worst spawn time in a frame %.2f ms (budget %.2f ms)"),
+				BenchmarkSpawned, BenchmarkFrames, BenchmarkWorstFrameMs, BenchmarkWorstSpawnMs, FrameBudgetMs);
+			bBenchmarkRunning = false;
+		}
+	}
+
+	if (GetNumQueued() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_SpawnQueue);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double EndTime = StartTime + FrameBudgetMs / 1000.0;
+	bool bTookStep = false;
+
+	for (int32 PriorityIndex = 0; PriorityIndex < (int32)ESpawnPriority::ESP_Max; ++PriorityIndex)
+	{
+		const bool bBudgeted = PriorityIndex != (int32)ESpawnPriority::ESP_Critical;
+		int32 NumDone = 0;
+
+		// Indexed every time, finishing a spawn can queue more (BeginPlay, callbacks) and grow the array
+		while (NumDone < Queues[PriorityIndex].Num())
+		{
+			// Always take at least one step so a tiny budget still gets through the queue
+			if (bBudgeted && bTookStep && FPlatformTime::Seconds() >= EndTime)
+			{
+				break;
+			}
+
+			bTookStep = true;
+			if (StepSpawn(Queues[PriorityIndex][NumDone]))
+			{
+				++NumDone;
+			}
+		}
+
+		Queues[PriorityIndex].RemoveAt(0, NumDone, false);
+		DEC_DWORD_STAT_BY(STAT_QueuedSpawns, NumDone);
+		if (bBenchmarkRunning)
+		{
+			BenchmarkSpawned += NumDone;
+		}
+	}
+
+	if (bBenchmarkRunning)
+	{
+		++BenchmarkFrames;
+		BenchmarkWorstSpawnMs = FMath::Max(BenchmarkWorstSpawnMs, (float)((FPlatformTime::Seconds() - StartTime) * 1000.0));
+	}
+}
+
+TStatId USpawnQueueSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USpawnQueueSubsystem, STATGROUP_Tickables);
+}
+
+bool USpawnQueueSubsystem::StepSpawn(FQueuedSpawn& Spawn)
+{
+	// Cancelled
+	if (Spawn.ActorClass == nullptr)
+	{
+		return true;
+	}
+
+	UWorld* World = GetWorld();
+	AActor* Actor = Spawn.DeferredActor.Get();
+	if (Actor == nullptr)
+	{
+		// A pooled item is already live, no need to construct anything
+		if (Spawn.ActorClass->IsChildOf(AItemBase::StaticClass()))
+		{
+			UItemPoolSubsystem* ItemPool = World->GetSubsystem<UItemPoolSubsystem>();
+			const TSubclassOf<AItemBase> ItemClass = *Spawn.ActorClass;
+			if (ItemPool && ItemPool->GetNumPooled(ItemClass) > 0)
+			{
+				AItemBase* Item = ItemPool->AcquireItem(ItemClass, Spawn.Transform);
+				INC_DWORD_STAT(STAT_QueuedSpawnsFinished);
+
+				// The callback may queue more spawns and move Spawn, don't touch it after this
+				FOnQueuedSpawnFinished OnFinished = MoveTemp(Spawn.OnFinished);
+				OnFinished.ExecuteIfBound(Item);
+				return true;
+			}
+		}
+
+		Actor = World->SpawnActorDeferred<AActor>(Spawn.ActorClass, Spawn.Transform, nullptr, nullptr, Spawn.CollisionHandling);
+		if (Actor)
+		{
+			// Finished on the next step, this frame if the budget allows
+			Spawn.DeferredActor = Actor;
+			return false;
+		}
+	}
+	else
+	{
+		// FinishSpawning runs BeginPlay, which may queue more spawns and move Spawn
+		const FTransform Transform = Spawn.Transform;
+		FOnQueuedSpawnFinished OnFinished = MoveTemp(Spawn.OnFinished);
+		Spawn.DeferredActor.Reset();
+
+		Actor->FinishSpawning(Transform);
+		INC_DWORD_STAT(STAT_QueuedSpawnsFinished);
+		OnFinished.ExecuteIfBound(Actor->IsPendingKill() ? nullptr : Actor);
+		return true;
+	}
+
+	// Failed to spawn
+	FOnQueuedSpawnFinished OnFinished = MoveTemp(Spawn.OnFinished);
+	OnFinished.ExecuteIfBound(nullptr);
+	return true;
+}
+
+void USpawnQueueSubsystem::RunBenchmark(const TArray<FString>& Args, UWorld* World)
+{
+	USpawnQueueSubsystem* SpawnQueue = World ? World->GetSubsystem<USpawnQueueSubsystem>() : nullptr;
+	UClass* ActorClass = Args.Num() > 0 ? LoadClass<AActor>(nullptr, *Args[0]) : nullptr;
+	if (SpawnQueue == nullptr || ActorClass == nullptr)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("USpawnQueueSubsystem::RunBenchmark, needs a game world and a valid actor class path"));
+		return;
+	}
+
+	const int32 Count = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 500;
+	const APlayerController* PC = World->GetFirstPlayerController();
+	const APawn* Pawn = PC ? PC->GetPawn() : nullptr;
+	const FVector Origin = Pawn ? Pawn->GetActorLocation() + Pawn->GetActorForwardVector() * 500.f : FVector::ZeroVector;
+
+	SpawnQueue->bBenchmarkRunning = true;
+	SpawnQueue->BenchmarkSpawned = 0;
+	SpawnQueue->BenchmarkFrames = 0;
+	SpawnQueue->BenchmarkWorstFrameMs = 0.f;
+	SpawnQueue->BenchmarkWorstSpawnMs = 0.f;
+	SpawnQueue->BenchmarkLastTickTime = 0.0;
+
+	// Grid in front of the player, 100 units apart
+	const int32 GridSize = FMath::CeilToInt(FMath::Sqrt((float)Count));
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const FVector Offset((Index / GridSize) * 100.f, (Index % GridSize - GridSize / 2) * 100.f, 0.f);
+		SpawnQueue->QueueSpawn(ActorClass, FTransform(Origin + Offset), ESpawnPriority::ESP_Normal);
+	}
+}
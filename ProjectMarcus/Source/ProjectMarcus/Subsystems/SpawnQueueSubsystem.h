@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProjectMarcus/Subsystems/ProjectMarcusTickableSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "SpawnQueueSubsystem.generated.h"
+
+// Order queued spawns are worked through in. Critical ignores the frame budget
+UENUM(BlueprintType)
+enum class ESpawnPriority : uint8
+{
+	ESP_Critical UMETA(DisplayName = "Critical"), // player facing, can't wait (default weapon)
+	ESP_High UMETA(DisplayName = "High"), // gameplay (enemy waves)
+	ESP_Normal UMETA(DisplayName = "Normal"), // loot drops
+	ESP_Low UMETA(DisplayName = "Low"), // anything that can show up late
+	ESP_Max UMETA(DisplayName = "InvalidMax")
+};
+
+// Called once the actor is live (BeginPlay has run), with nullptr if the spawn failed
+DECLARE_DELEGATE_OneParam(FOnQueuedSpawnFinished, AActor*);
+
+/**
+ * Spreads actor spawning over frames so a wave or a loot explosion doesn't land in one frame.
+ * Each spawn is two steps, SpawnActorDeferred (construct) and FinishSpawning (construction script, component
+ * registration, BeginPlay), and the queue only takes steps while this frames FrameBudgetMs lasts. Items with a pooled
+ * actor of their class are taken from the UItemPoolSubsystem instead, which is a single cheap step.
+ */
+UCLASS(Config = Game)
+class PROJECTMARCUS_API USpawnQueueSubsystem : public UProjectMarcusTickableSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Returns an id for CancelSpawn, 0 if ActorClass is null. CollisionHandling Undefined uses the classes own setting
+	uint32 QueueSpawn(TSubclassOf<AActor> ActorClass, const FTransform& Transform, ESpawnPriority Priority = ESpawnPriority::ESP_Normal, FOnQueuedSpawnFinished OnFinished = FOnQueuedSpawnFinished(),
+		ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::Undefined);
+
+	// Drops a queued spawn, destroying the actor if it was already constructed. The callback isn't called
+	bool CancelSpawn(uint32 SpawnId);
+
+	int32 GetNumQueued() const;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// ProjectMarcus.SpawnQueueBenchmark ClassPath [Count], queues Count (default 500) spawns in front of the player and
+	// logs the worst frame once they're all live
+	static void RunBenchmark(const TArray<FString>& Args, UWorld* World);
+
+private:
+	struct FQueuedSpawn
+	{
+		uint32 Id = 0;
+		TSubclassOf<AActor> ActorClass;
+		FTransform Transform;
+		ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::Undefined;
+		FOnQueuedSpawnFinished OnFinished;
+
+		// Constructed but not finished yet
+		TWeakObjectPtr<AActor> DeferredActor;
+	};
+
+	// Takes the next step of Spawn, true once it's done (live, failed or taken from a pool)
+	bool StepSpawn(FQueuedSpawn& Spawn);
+
+	// Budget for one frame of spawning
+	UPROPERTY(Config)
+	float FrameBudgetMs = 2.f;
+
+	// FIFO per priority
+	TArray<FQueuedSpawn> Queues[(int32)ESpawnPriority::ESP_Max];
+
+	uint32 NextSpawnId = 1;
+
+	// Running benchmark, reported once the queue drains
+	bool bBenchmarkRunning = false;
+	int32 BenchmarkSpawned = 0;
+	int32 BenchmarkFrames = 0;
+	float BenchmarkWorstFrameMs = 0.f;
+	float BenchmarkWorstSpawnMs = 0.f;
+	// Wall time of the last tick, the next one measures the frame in between
+	double BenchmarkLastTickTime = 0.0;
+};
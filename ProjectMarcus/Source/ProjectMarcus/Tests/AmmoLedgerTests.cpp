@@ -0,0 +1,118 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/AmmoLedger.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AmmoLedgerTests
+{
+	// Types ConsumeChanges reported, with their counts
+	TArray<TPair<EAmmoType, int32>> ConsumeChanges(FAmmoLedger& Ledger)
+	{
+		TArray<TPair<EAmmoType, int32>> Changes;
+		Ledger.ConsumeChanges([&Changes](EAmmoType AmmoType, int32 Count) { Changes.Emplace(AmmoType, Count); });
+		return Changes;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAmmoLedgerAddRemoveTest, "ProjectMarcus.Ammo.Ledger.AddRemove", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FAmmoLedgerAddRemoveTest::RunTest(const FString& Parameters)
+{
+	FAmmoLedger Ledger;
+	TestEqual(TEXT("Starts empty"), Ledger.Get(EAmmoType::EAT_9mm), 0);
+	TestEqual(TEXT("Default cap"), Ledger.GetCap(EAmmoType::EAT_9mm), FAmmoLedger::DefaultCap);
+	TestFalse(TEXT("Has nothing"), Ledger.Has(EAmmoType::EAT_9mm));
+
+	TestEqual(TEXT("Add"), Ledger.Add(EAmmoType::EAT_9mm, 30), 30);
+	TestEqual(TEXT("Count after add"), Ledger.Get(EAmmoType::EAT_9mm), 30);
+	TestTrue(TEXT("Has some"), Ledger.Has(EAmmoType::EAT_9mm));
+	TestEqual(TEXT("Other type untouched"), Ledger.Get(EAmmoType::EAT_AR), 0);
+
+	TestEqual(TEXT("Remove"), Ledger.Remove(EAmmoType::EAT_9mm, 12), 12);
+	TestEqual(TEXT("Remove more than there is"), Ledger.Remove(EAmmoType::EAT_9mm, 100), 18);
+	TestEqual(TEXT("Count after removing everything"), Ledger.Get(EAmmoType::EAT_9mm), 0);
+	TestEqual(TEXT("Remove from empty"), Ledger.Remove(EAmmoType::EAT_9mm, 1), 0);
+
+	TestEqual(TEXT("Add nothing"), Ledger.Add(EAmmoType::EAT_AR, 0), 0);
+	TestEqual(TEXT("Add negative"), Ledger.Add(EAmmoType::EAT_AR, -5), 0);
+	TestEqual(TEXT("Remove negative"), Ledger.Remove(EAmmoType::EAT_AR, -5), 0);
+	TestEqual(TEXT("Count unchanged"), Ledger.Get(EAmmoType::EAT_AR), 0);
+
+	// Out of range types read as empty
+	TestEqual(TEXT("Invalid type"), Ledger.Get(EAmmoType::EAT_Max), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAmmoLedgerClampTest, "ProjectMarcus.Ammo.Ledger.Clamp", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FAmmoLedgerClampTest::RunTest(const FString& Parameters)
+{
+	FAmmoLedger Ledger;
+	Ledger.SetCap(EAmmoType::EAT_AR, 120);
+
+	TestEqual(TEXT("Add up to the cap"), Ledger.Add(EAmmoType::EAT_AR, 100), 100);
+	TestEqual(TEXT("Add past the cap only adds what fits"), Ledger.Add(EAmmoType::EAT_AR, 50), 20);
+	TestEqual(TEXT("Add when full"), Ledger.Add(EAmmoType::EAT_AR, 1), 0);
+	TestEqual(TEXT("Count at the cap"), Ledger.Get(EAmmoType::EAT_AR), 120);
+
+	Ledger.Set(EAmmoType::EAT_AR, 500);
+	TestEqual(TEXT("Set clamps to the cap"), Ledger.Get(EAmmoType::EAT_AR), 120);
+	Ledger.Set(EAmmoType::EAT_AR, -10);
+	TestEqual(TEXT("Set clamps to 0"), Ledger.Get(EAmmoType::EAT_AR), 0);
+
+	Ledger.Set(EAmmoType::EAT_AR, 90);
+	Ledger.SetCap(EAmmoType::EAT_AR, 60);
+	TestEqual(TEXT("Lowering the cap clamps the count"), Ledger.Get(EAmmoType::EAT_AR), 60);
+	Ledger.SetCap(EAmmoType::EAT_AR, 200);
+	TestEqual(TEXT("Raising the cap leaves the count"), Ledger.Get(EAmmoType::EAT_AR), 60);
+	Ledger.SetCap(EAmmoType::EAT_AR, -1);
+	TestEqual(TEXT("Negative cap clamps to 0"), Ledger.GetCap(EAmmoType::EAT_AR), 0);
+	TestEqual(TEXT("Count clamped to a 0 cap"), Ledger.Get(EAmmoType::EAT_AR), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAmmoLedgerChangesTest, "ProjectMarcus.Ammo.Ledger.Changes", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FAmmoLedgerChangesTest::RunTest(const FString& Parameters)
+{
+	using namespace AmmoLedgerTests;
+
+	FAmmoLedger Ledger;
+	TestFalse(TEXT("No changes to start with"), Ledger.HasChanges());
+
+	Ledger.Add(EAmmoType::EAT_AR, 10);
+	Ledger.Add(EAmmoType::EAT_AR, 5);
+	TestTrue(TEXT("AR changed"), Ledger.IsChanged(EAmmoType::EAT_AR));
+	TestFalse(TEXT("9mm not changed"), Ledger.IsChanged(EAmmoType::EAT_9mm));
+
+	// Several changes to one type are reported once with the latest count
+	TArray<TPair<EAmmoType, int32>> Changes = ConsumeChanges(Ledger);
+	if (TestEqual(TEXT("One type reported"), Changes.Num(), 1))
+	{
+		TestTrue(TEXT("Reported type"), Changes[0].Key == EAmmoType::EAT_AR);
+		TestEqual(TEXT("Reported count"), Changes[0].Value, 15);
+	}
+	TestFalse(TEXT("Consumed"), Ledger.HasChanges());
+
+	// Calls that don't change the count don't mark it
+	Ledger.Set(EAmmoType::EAT_AR, 15);
+	Ledger.Remove(EAmmoType::EAT_9mm, 5);
+	Ledger.SetCap(EAmmoType::EAT_AR, 500);
+	TestFalse(TEXT("No-op calls aren't changes"), Ledger.HasChanges());
+
+	Ledger.MarkAllChanged();
+	Changes = ConsumeChanges(Ledger);
+	TestEqual(TEXT("Every type reported"), Changes.Num(), FAmmoLedger::NumTypes);
+	for (int32 Index = 0; Index < Changes.Num(); ++Index)
+	{
+		TestTrue(TEXT("Reported in enum order"), Changes[Index].Key == (EAmmoType)Index);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Enemies/Enemy.h"
+#include "ProjectMarcus/ProjectMarcusGameModeBase.h"
+#include "ProjectMarcus/Tests/ProjectMarcusTestWorld.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "IAnimationBudgetAllocator.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace EnemyAnimBudgetBenchmarkTests
+{
+	constexpr int32 NumEnemies = 300;
+	constexpr int32 NumWarmupFrames = 30;
+	constexpr int32 NumFrames = 300;
+	constexpr float DeltaTime = 1.f / 60.f;
+
+	// Average game thread ms of a full world tick
+	double MeasureFrameMs(FProjectMarcusTestWorld& TestWorld)
+	{
+		for (int32 Frame = 0; Frame < NumWarmupFrames; ++Frame)
+		{
+			TestWorld.Tick(DeltaTime);
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			TestWorld.Tick(DeltaTime);
+		}
+		return (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumFrames;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEnemyAnimBudgetBenchmarkTest, "ProjectMarcus.Enemies.AnimBudget.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FEnemyAnimBudgetBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace EnemyAnimBudgetBenchmarkTests;
+
+	UClass* EnemyClass = LoadClass<AEnemy>(nullptr, TEXT("/Game/_Game/Enemies/Enemy_BP.Enemy_BP_C"));
+	if (!TestNotNull(TEXT("Enemy blueprint"), EnemyClass))
+	{
+		return false;
+	}
+
+	// The budget the game runs with, from the game mode blueprint if it loads
+	UClass* GameModeClass = LoadClass<AProjectMarcusGameModeBase>(nullptr, TEXT("/Game/_Game/GameMode/ProjectMarcusGameModeBase_BP.ProjectMarcusGameModeBase_BP_C"));
+	const AProjectMarcusGameModeBase* GameMode = GameModeClass ? GameModeClass->GetDefaultObject<AProjectMarcusGameModeBase>() : GetDefault<AProjectMarcusGameModeBase>();
+	const FAnimationBudgetAllocatorParameters& Budget = GameMode->GetAnimationBudget();
+
+	FProjectMarcusTestWorld TestWorld;
+	IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(TestWorld.World);
+	if (!TestNotNull(TEXT("Budget allocator"), Allocator))
+	{
+		return false;
+	}
+	Allocator->SetParameters(Budget);
+	Allocator->SetEnabled(true);
+	TestWorld.BeginPlay();
+
+	// Everything but the enemies, so the difference below is their anim cost
+	const double EmptyFrameMs = MeasureFrameMs(TestWorld);
+
+	// A crowd right in front of the camera: nothing renders headless, so force the on screen anim path, and keep them
+	// from falling through the empty world so movement doesn't muddy the numbers
+	for (int32 Idx = 0; Idx < NumEnemies; ++Idx)
+	{
+		const FVector Location((Idx % 20) * 200.f, (Idx / 20) * 200.f, 0.f);
+		AEnemy* Enemy = TestWorld.World->SpawnActor<AEnemy>(EnemyClass, FTransform(Location));
+		if (!TestNotNull(TEXT("Enemy"), Enemy))
+		{
+			return false;
+		}
+
+		Enemy->GetCharacterMovement()->DisableMovement();
+		Enemy->GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+		if (USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(Enemy->GetMesh()))
+		{
+			BudgetedMesh->SetComponentSignificance(1.f);
+		}
+	}
+
+	// Parallel evaluation on (the default) leaves the game thread with tick, task dispatch and completion
+	const double ParallelFrameMs = MeasureFrameMs(TestWorld);
+
+	// With it off every evaluation runs inline, what's added is the work the anim workers take off the game thread
+	double SerialFrameMs = ParallelFrameMs;
+	if (IConsoleVariable* ParallelAnimEvaluation = IConsoleManager::Get().FindConsoleVariable(TEXT("a.ParallelAnimEvaluation")))
+	{
+		const int32 OldValue = ParallelAnimEvaluation->GetInt();
+		ParallelAnimEvaluation->Set(0, ECVF_SetByCode);
+		SerialFrameMs = MeasureFrameMs(TestWorld);
+		ParallelAnimEvaluation->Set(OldValue, ECVF_SetByCode);
+	}
+
+	const double GameThreadAnimMs = FMath::Max(ParallelFrameMs - EmptyFrameMs, 0.0);
+	const double WorkerAnimMs = FMath::Max(SerialFrameMs - ParallelFrameMs, 0.0);
+	AddInfo(FString::Printf(TEXT("%d enemies: game thread anim %.3fms, worker anim %.3fms per frame, budget %.3fms (empty frame %.3fms)"),
+		NumEnemies, GameThreadAnimMs, WorkerAnimMs, Budget.BudgetInMs, EmptyFrameMs));
+
+	// The allocator throttles ticks to hold the game thread cost at the budget, slack for its reaction time and a loaded machine
+	TestTrue(FString::Printf(TEXT("Game thread anim %.3fms is within the %.3fms budget"), GameThreadAnimMs, Budget.BudgetInMs), GameThreadAnimMs <= Budget.BudgetInMs * 1.5 + 0.5);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,228 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Combat/ExplosionSubsystem.h"
+#include "ProjectMarcus/Combat/DamageQueueSubsystem.h"
+#include "ProjectMarcus/Props/ExplodingProp.h"
+#include "ProjectMarcus/Props/ExplodingPropManager.h"
+#include "ProjectMarcus/Tests/ProjectMarcusTestWorld.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Components/SphereComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ExplosionSubsystemTests
+{
+	// Ring and index within the ring, packed into the origin
+	UExplosionSubsystem::FExplosionRequest MakeRequest(int32 Ring, int32 Index)
+	{
+		UExplosionSubsystem::FExplosionRequest Request;
+		Request.Origin = FVector(Ring, Index, 0.f);
+		return Request;
+	}
+
+	void BusyWait(double Seconds)
+	{
+		const double EndTime = FPlatformTime::Seconds() + Seconds;
+		while (FPlatformTime::Seconds() < EndTime)
+		{
+		}
+	}
+
+	// Close enough for an explosion (default 500 radius) to reach the next prop out, too far for the one after
+	constexpr float PropSpacing = 300.f;
+
+	// The prop blueprints add the mesh, a WorldDynamic sphere the size of a barrel stands in for it
+	AExplodingProp* SpawnProp(UWorld* World, const FVector& Location)
+	{
+		AExplodingProp* Prop = World->SpawnActor<AExplodingProp>();
+		USphereComponent* Collision = NewObject<USphereComponent>(Prop);
+		Collision->InitSphereRadius(50.f);
+		Collision->SetCollisionObjectType(ECC_WorldDynamic);
+		Collision->SetCollisionResponseToAllChannels(ECR_Block);
+		Collision->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		Prop->SetRootComponent(Collision);
+		Collision->RegisterComponent();
+		Collision->SetWorldLocation(Location);
+		return Prop;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FExplosionSubsystemChainOrderTest, "ProjectMarcus.Combat.Explosions.ChainOrder", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FExplosionSubsystemChainOrderTest::RunTest(const FString& Parameters)
+{
+	using namespace ExplosionSubsystemTests;
+
+	FProjectMarcusTestWorld TestWorld;
+	UExplosionSubsystem* Explosions = TestWorld.World->GetSubsystem<UExplosionSubsystem>();
+	if (!TestNotNull(TEXT("Subsystem"), Explosions))
+	{
+		return false;
+	}
+
+	// Every explosion sets off two more, out to the fourth ring
+	static constexpr int32 NumRings = 4;
+	TArray<FIntPoint> Order;
+	auto ExplodeFunc = [Explosions, &Order](const UExplosionSubsystem::FExplosionRequest& Request)
+	{
+		const FIntPoint Explosion(FMath::RoundToInt(Request.Origin.X), FMath::RoundToInt(Request.Origin.Y));
+		Order.Add(Explosion);
+		if (Explosion.X + 1 < NumRings)
+		{
+			Explosions->QueueExplosion(MakeRequest(Explosion.X + 1, Explosion.Y * 2));
+			Explosions->QueueExplosion(MakeRequest(Explosion.X + 1, Explosion.Y * 2 + 1));
+		}
+	};
+
+	Explosions->QueueExplosion(MakeRequest(0, 0));
+
+	// Unlimited budget, each frame is exactly one ring because what a ring sets off waits for the next frame
+	for (int32 Ring = 0; Ring < NumRings; ++Ring)
+	{
+		const int32 FirstInFrame = Order.Num();
+		const int32 NumExploded = Explosions->ProcessQueue(1000.f, 1, ExplodeFunc);
+		TestEqual(FString::Printf(TEXT("Ring %d goes off in one frame"), Ring), NumExploded, 1 << Ring);
+
+		for (int32 Idx = FirstInFrame; Idx < Order.Num(); ++Idx)
+		{
+			TestEqual(TEXT("Ring"), Order[Idx].X, Ring);
+			TestEqual(TEXT("FIFO within the ring"), Order[Idx].Y, Idx - FirstInFrame);
+		}
+	}
+
+	TestEqual(TEXT("Drained"), Explosions->GetNumQueued(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FExplosionSubsystemFrameBudgetTest, "ProjectMarcus.Combat.Explosions.FrameBudget", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FExplosionSubsystemFrameBudgetTest::RunTest(const FString& Parameters)
+{
+	using namespace ExplosionSubsystemTests;
+
+	FProjectMarcusTestWorld TestWorld;
+	UExplosionSubsystem* Explosions = TestWorld.World->GetSubsystem<UExplosionSubsystem>();
+	if (!TestNotNull(TEXT("Subsystem"), Explosions))
+	{
+		return false;
+	}
+
+	constexpr int32 NumQueued = 40;
+	constexpr double ExplosionSeconds = 0.00025;
+	constexpr float BudgetMs = 1.f;
+
+	int32 NextExpected = 0;
+	bool bInOrder = true;
+	auto ExplodeFunc = [&NextExpected, &bInOrder](const UExplosionSubsystem::FExplosionRequest& Request)
+	{
+		bInOrder &= FMath::RoundToInt(Request.Origin.Y) == NextExpected++;
+		BusyWait(ExplosionSeconds);
+	};
+
+	// No budget at all still moves MinExplosions a frame
+	for (int32 Idx = 0; Idx < NumQueued; ++Idx)
+	{
+		Explosions->QueueExplosion(MakeRequest(0, Idx));
+	}
+	TestEqual(TEXT("Zero budget runs the minimum"), Explosions->ProcessQueue(0.f, 2, ExplodeFunc), 2);
+	TestEqual(TEXT("Rest deferred"), Explosions->GetNumQueued(), NumQueued - 2);
+
+	// A frame stops starting explosions once the budget is spent, so it runs over by at most one explosion
+	int32 NumFrames = 0;
+	while (Explosions->GetNumQueued() > 0 && NumFrames < NumQueued)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		const int32 NumExploded = Explosions->ProcessQueue(BudgetMs, 1, ExplodeFunc);
+		const double FrameMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		++NumFrames;
+
+		TestTrue(TEXT("At least one a frame"), NumExploded >= 1);
+		// Generous slack for a loaded machine, the failure this catches is the whole queue going off in one frame
+		TestTrue(FString::Printf(TEXT("Frame took %.3fms for %d explosions"), FrameMs, NumExploded), NumExploded == 1 || FrameMs <= BudgetMs + ExplosionSeconds * 1000.0 + 2.0);
+	}
+
+	TestEqual(TEXT("Drained"), Explosions->GetNumQueued(), 0);
+	TestEqual(TEXT("Every explosion went off"), NextExpected, NumQueued);
+	TestTrue(TEXT("Spread over several frames"), NumFrames > 1);
+	TestTrue(TEXT("In queue order"), bInOrder);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FExplosionSubsystemPropChainTest, "ProjectMarcus.Combat.Explosions.PropChain", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FExplosionSubsystemPropChainTest::RunTest(const FString& Parameters)
+{
+	using namespace ExplosionSubsystemTests;
+
+	FProjectMarcusTestWorld TestWorld;
+	TestWorld.BeginPlay();
+	UWorld* World = TestWorld.World;
+	UDamageQueueSubsystem* DamageQueue = World->GetSubsystem<UDamageQueueSubsystem>();
+	UExplosionSubsystem* Explosions = World->GetSubsystem<UExplosionSubsystem>();
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!TestNotNull(TEXT("Damage queue"), DamageQueue) || !TestNotNull(TEXT("Subsystem"), Explosions) || !TestNotNull(TEXT("Cube mesh"), Cube))
+	{
+		return false;
+	}
+
+	// Two lines of props, one of actors and one of instances on a manager, far enough apart not to set each other off.
+	// Ring 0 is the middle prop of a line, ring N the two props N spacings either side of it
+	constexpr int32 NumRings = 5;
+	constexpr float ManagerLineY = 5000.f;
+
+	AExplodingPropManager* Manager = World->SpawnActor<AExplodingPropManager>();
+	Manager->FindComponentByClass<UHierarchicalInstancedStaticMeshComponent>()->SetStaticMesh(Cube);
+
+	// Ring of each prop actor
+	TArray<TPair<int32, TWeakObjectPtr<AExplodingProp>>> Props;
+	AExplodingProp* MiddleProp = nullptr;
+	int32 MiddleManagerProp = INDEX_NONE;
+	for (int32 Slot = 1 - NumRings; Slot < NumRings; ++Slot)
+	{
+		AExplodingProp* Prop = SpawnProp(World, FVector(Slot * PropSpacing, 0.f, 0.f));
+		const int32 PropId = Manager->AddProp(FTransform(FVector(Slot * PropSpacing, ManagerLineY, 0.f)));
+		Props.Emplace(FMath::Abs(Slot), Prop);
+		if (Slot == 0)
+		{
+			MiddleProp = Prop;
+			MiddleManagerProp = PropId;
+		}
+	}
+
+	const int32 NumPerLine = Props.Num();
+	TestEqual(TEXT("Manager has a prop per actor"), Manager->GetNumProps(), NumPerLine);
+	TestTrue(TEXT("Props registered with the damage queue"), DamageQueue->IsRegistered(MiddleProp));
+
+	// Shoot the middle of both lines, the rest is up to the subsystems
+	DamageQueue->QueueDamage(MiddleProp, 100.f, MiddleProp->GetActorLocation(), false, nullptr, nullptr);
+	DamageQueue->QueueDamage(Manager, 100.f, FVector(0.f, ManagerLineY, 0.f), false, nullptr, nullptr, MiddleManagerProp);
+
+	// Each frame the damage pass kills a ring and the explosion tick later that frame sets it off, which damages the
+	// next ring for the following frame's pass. The whole ring fits in the frame budget, so nothing is left queued
+	for (int32 Ring = 0; Ring < NumRings; ++Ring)
+	{
+		TestWorld.Tick(1.f / 60.f);
+
+		for (const TPair<int32, TWeakObjectPtr<AExplodingProp>>& Prop : Props)
+		{
+			TestEqual(FString::Printf(TEXT("Frame %d, ring %d prop exploded"), Ring, Prop.Key), !Prop.Value.IsValid(), Prop.Key <= Ring);
+		}
+
+		const int32 NumExploded = 1 + Ring * 2;
+		TestEqual(FString::Printf(TEXT("Frame %d, manager props left"), Ring), Manager->GetNumProps(), NumPerLine - NumExploded);
+		TestEqual(FString::Printf(TEXT("Frame %d, ring went off within the budget"), Ring), Explosions->GetNumQueued(), 0);
+	}
+
+	// The last ring's explosions reach nothing
+	TestWorld.Tick(1.f / 60.f);
+	TestEqual(TEXT("Manager empty"), Manager->GetNumProps(), 0);
+	TestEqual(TEXT("Nothing queued"), Explosions->GetNumQueued(), 0);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
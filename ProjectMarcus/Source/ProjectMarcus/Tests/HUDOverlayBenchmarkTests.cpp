@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Tests/HUDOverlayTestWidget.h"
+#include "ProjectMarcus/PlayerController/ProjectMarcusPlayerController.h"
+#include "ProjectMarcus/UI/HUDViewModel.h"
+#include "ProjectMarcus/Tests/ProjectMarcusTestWorld.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Rendering/DrawElements.h"
+#include "Widgets/SVirtualWindow.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace HUDOverlayBenchmarkTests
+{
+	constexpr int32 NumFrames = 600;
+	constexpr float DeltaTime = 1.f / 60.f;
+
+	struct FFrameTimes
+	{
+		double PrepassMs = 0.0;
+		double PaintMs = 0.0;
+	};
+
+	// Prepass and paint of the window for NumFrames, with UpdateFunc run before each frame like the game thread does
+	FFrameTimes DrawFrames(const TSharedRef<SVirtualWindow>& Window, TFunctionRef<void(int32)> UpdateFunc)
+	{
+		FFrameTimes Times;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			UpdateFunc(Frame);
+
+			FSlateWindowElementList ElementList(Window);
+
+			double StartTime = FPlatformTime::Seconds();
+			Window->SlatePrepass(1.f);
+			Times.PrepassMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+			StartTime = FPlatformTime::Seconds();
+			Window->PaintWindow(Frame * DeltaTime, DeltaTime, ElementList, FWidgetStyle(), true);
+			Times.PaintMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		}
+		return Times;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHUDOverlayBenchmarkTest, "ProjectMarcus.UI.HUDOverlay.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FHUDOverlayBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace HUDOverlayBenchmarkTests;
+
+	// Text has to be measured, which needs Slate's font services even without a renderer
+	if (!FSlateApplication::IsInitialized())
+	{
+		AddWarning(TEXT("Slate isn't initialized, skipping the HUD overlay benchmark"));
+		return true;
+	}
+
+	FProjectMarcusTestWorld TestWorld;
+	AProjectMarcusPlayerController* PC = TestWorld.World->SpawnActor<AProjectMarcusPlayerController>();
+	UHUDViewModel* ViewModel = PC ? PC->GetHUDViewModel() : nullptr;
+	if (!TestNotNull(TEXT("View model"), ViewModel))
+	{
+		return false;
+	}
+	ViewModel->SetClipAmmo(30);
+	ViewModel->SetStashAmmo(120);
+
+	UHUDOverlayTestWidget* Widget = CreateWidget<UHUDOverlayTestWidget>(PC);
+	if (!TestNotNull(TEXT("Widget"), Widget))
+	{
+		return false;
+	}
+
+	// Drawn offscreen into a virtual window, TakeWidget constructs the widget which binds the view model
+	TSharedRef<SVirtualWindow> Window = SNew(SVirtualWindow).Size(FVector2D(1920.f, 1080.f));
+	Window->SetContent(Widget->TakeWidget());
+	TestTrue(TEXT("Widget shows the view model on construct"), Widget->GetClipAmmoText().EqualTo(FText::AsNumber(30)));
+
+	// Warm up text layout caches so the first scenario doesn't pay for them
+	DrawFrames(Window, [](int32 Frame) {});
+
+	// Polled, every element rewritten every frame as property bindings would, with nothing actually changing
+	const FFrameTimes Polled = DrawFrames(Window, [Widget](int32 Frame) { Widget->PollViewModel(); });
+
+	// Pushed with no view model changes, the overlay is never touched
+	const FFrameTimes Unchanged = DrawFrames(Window, [](int32 Frame) {});
+
+	// Pushed while firing, the clip and spread change every frame
+	const FFrameTimes Changing = DrawFrames(Window, [ViewModel](int32 Frame)
+	{
+		ViewModel->SetClipAmmo(30 - Frame % 30);
+		ViewModel->SetCrosshairSpread((Frame % 30) / 30.f);
+	});
+
+	const TCHAR* Format = TEXT("%s: prepass %.2fus, paint %.2fus per frame");
+	AddInfo(FString::Printf(Format, TEXT("Polled, no changes"), Polled.PrepassMs * 1000.0 / NumFrames, Polled.PaintMs * 1000.0 / NumFrames));
+	AddInfo(FString::Printf(Format, TEXT("Pushed, no changes"), Unchanged.PrepassMs * 1000.0 / NumFrames, Unchanged.PaintMs * 1000.0 / NumFrames));
+	AddInfo(FString::Printf(Format, TEXT("Pushed, changing every frame"), Changing.PrepassMs * 1000.0 / NumFrames, Changing.PaintMs * 1000.0 / NumFrames));
+
+	// The last pushed change reached the widget through the events alone
+	TestTrue(TEXT("Widget follows the view model"), Widget->GetClipAmmoText().EqualTo(FText::AsNumber(ViewModel->GetClipAmmo())));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
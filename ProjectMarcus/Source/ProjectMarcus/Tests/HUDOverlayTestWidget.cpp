@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Tests/HUDOverlayTestWidget.h"
+#include "ProjectMarcus/UI/HUDViewModel.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/Image.h"
+#include "Components/InvalidationBox.h"
+#include "Components/TextBlock.h"
+#include "Components/VerticalBox.h"
+
+void UHUDOverlayTestWidget::PollViewModel()
+{
+	if (ViewModel)
+	{
+		UpdateClipAmmo(ViewModel->GetClipAmmo());
+		UpdateStashAmmo(ViewModel->GetStashAmmo());
+		UpdateCrosshairSpread(ViewModel->GetCrosshairSpread());
+		UpdateEquippedSlot(ViewModel->GetEquippedSlot());
+	}
+}
+
+FText UHUDOverlayTestWidget::GetClipAmmoText() const
+{
+	return ClipAmmoText ? ClipAmmoText->GetText() : FText::GetEmpty();
+}
+
+void UHUDOverlayTestWidget::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	// Nothing inside changes on frames without an event, so the whole overlay can cache its paint
+	UInvalidationBox* Root = WidgetTree->ConstructWidget<UInvalidationBox>();
+	UVerticalBox* Elements = WidgetTree->ConstructWidget<UVerticalBox>();
+	Root->AddChild(Elements);
+
+	ClipAmmoText = WidgetTree->ConstructWidget<UTextBlock>();
+	StashAmmoText = WidgetTree->ConstructWidget<UTextBlock>();
+	EquippedSlotText = WidgetTree->ConstructWidget<UTextBlock>();
+	Crosshair = WidgetTree->ConstructWidget<UImage>();
+	Elements->AddChild(ClipAmmoText);
+	Elements->AddChild(StashAmmoText);
+	Elements->AddChild(EquippedSlotText);
+	Elements->AddChild(Crosshair);
+
+	WidgetTree->RootWidget = Root;
+}
+
+void UHUDOverlayTestWidget::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	if (ViewModel)
+	{
+		ViewModel->OnClipAmmoChanged.AddDynamic(this, &UHUDOverlayTestWidget::UpdateClipAmmo);
+		ViewModel->OnStashAmmoChanged.AddDynamic(this, &UHUDOverlayTestWidget::UpdateStashAmmo);
+		ViewModel->OnCrosshairSpreadChanged.AddDynamic(this, &UHUDOverlayTestWidget::UpdateCrosshairSpread);
+		ViewModel->OnEquippedSlotChanged.AddDynamic(this, &UHUDOverlayTestWidget::UpdateEquippedSlot);
+		PollViewModel();
+	}
+}
+
+void UHUDOverlayTestWidget::UpdateClipAmmo(int32 ClipAmmo)
+{
+	ClipAmmoText->SetText(FText::AsNumber(ClipAmmo));
+}
+
+void UHUDOverlayTestWidget::UpdateStashAmmo(int32 StashAmmo)
+{
+	StashAmmoText->SetText(FText::AsNumber(StashAmmo));
+}
+
+void UHUDOverlayTestWidget::UpdateCrosshairSpread(float CrosshairSpread)
+{
+	Crosshair->SetRenderScale(FVector2D(1.f + CrosshairSpread));
+}
+
+void UHUDOverlayTestWidget::UpdateEquippedSlot(int32 EquippedSlot)
+{
+	EquippedSlotText->SetText(FText::AsNumber(EquippedSlot));
+}
@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProjectMarcus/UI/HUDOverlayWidget.h"
+#include "HUDOverlayTestWidget.generated.h"
+
+// Stands in for the HUD overlay blueprint in the automation tests: text blocks and a crosshair inside an invalidation box,
+// redrawn from the view model events the way the blueprint does
+UCLASS(Transient, NotBlueprintable)
+class PROJECTMARCUS_API UHUDOverlayTestWidget : public UHUDOverlayWidget
+{
+	GENERATED_BODY()
+
+public:
+	// Sets every element from the view model whether it changed or not, what per frame property bindings cost
+	void PollViewModel();
+
+	FText GetClipAmmoText() const;
+
+protected:
+	virtual void NativeOnInitialized() override;
+	virtual void NativeConstruct() override;
+
+private:
+	UFUNCTION()
+	void UpdateClipAmmo(int32 ClipAmmo);
+
+	UFUNCTION()
+	void UpdateStashAmmo(int32 StashAmmo);
+
+	UFUNCTION()
+	void UpdateCrosshairSpread(float CrosshairSpread);
+
+	UFUNCTION()
+	void UpdateEquippedSlot(int32 EquippedSlot);
+
+	UPROPERTY()
+	class UTextBlock* ClipAmmoText = nullptr;
+
+	UPROPERTY()
+	class UTextBlock* StashAmmoText = nullptr;
+
+	UPROPERTY()
+	class UTextBlock* EquippedSlotText = nullptr;
+
+	UPROPERTY()
+	class UImage* Crosshair = nullptr;
+};
@@ -0,0 +1,147 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Inventory/InventoryComponent.h"
+#include "ProjectMarcus/Interactables/ItemBase.h"
+#include "ProjectMarcus/Tests/InventoryTestListener.h"
+#include "ProjectMarcus/Tests/ProjectMarcusTestWorld.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace InventoryComponentTests
+{
+	UInventoryComponent* CreateInventory(UWorld* World)
+	{
+		AActor* Owner = World->SpawnActor<AActor>();
+		return NewObject<UInventoryComponent>(Owner);
+	}
+
+	UInventoryTestListener* CreateListener(UInventoryComponent* Inventory)
+	{
+		UInventoryTestListener* Listener = NewObject<UInventoryTestListener>(Inventory);
+		Inventory->GetEquipItemDelegate().AddDynamic(Listener, &UInventoryTestListener::OnEquipItem);
+		Inventory->GetHighlightIconDelegate().AddDynamic(Listener, &UInventoryTestListener::OnHighlightIcon);
+		return Listener;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryComponentSlotsTest, "ProjectMarcus.Inventory.Slots", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FInventoryComponentSlotsTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryComponentTests;
+
+	FProjectMarcusTestWorld TestWorld;
+	UInventoryComponent* Inventory = CreateInventory(TestWorld.World);
+
+	TArray<AItemBase*> Items;
+	for (int32 Idx = 0; Idx < UInventoryComponent::NumSlots + 1; ++Idx)
+	{
+		Items.Add(TestWorld.World->SpawnActor<AItemBase>());
+	}
+
+	TestEqual(TEXT("Empty"), Inventory->GetNumItems(), 0);
+	TestEqual(TEXT("First free slot when empty"), Inventory->GetFirstFreeSlot(), 0);
+	TestEqual(TEXT("Adding nothing"), Inventory->AddItem(nullptr), (int32)INDEX_NONE);
+
+	// Fills in slot order
+	for (int32 Slot = 0; Slot < UInventoryComponent::NumSlots; ++Slot)
+	{
+		TestEqual(TEXT("Added to the first free slot"), Inventory->AddItem(Items[Slot]), Slot);
+		TestEqual(TEXT("Item knows its slot"), Items[Slot]->GetInventorySlotIndex(), Slot);
+	}
+	TestTrue(TEXT("Full"), Inventory->IsFull());
+	TestEqual(TEXT("Item count when full"), Inventory->GetNumItems(), UInventoryComponent::NumSlots);
+	TestEqual(TEXT("No free slot when full"), Inventory->GetFirstFreeSlot(), (int32)INDEX_NONE);
+	TestEqual(TEXT("Adding to a full inventory"), Inventory->AddItem(Items.Last()), (int32)INDEX_NONE);
+
+	// Holes are refilled lowest first
+	TestTrue(TEXT("Removed item"), Inventory->RemoveItem(4) == Items[4]);
+	TestEqual(TEXT("Removed item has no slot"), Items[4]->GetInventorySlotIndex(), -1);
+	TestTrue(TEXT("Removed item"), Inventory->RemoveItem(1) == Items[1]);
+	TestTrue(TEXT("Removing an empty slot"), Inventory->RemoveItem(1) == nullptr);
+	TestEqual(TEXT("Item count after removing"), Inventory->GetNumItems(), UInventoryComponent::NumSlots - 2);
+	TestEqual(TEXT("Lowest hole is first"), Inventory->GetFirstFreeSlot(), 1);
+	TestEqual(TEXT("Refill lowest hole"), Inventory->AddItem(Items.Last()), 1);
+	TestEqual(TEXT("Next hole"), Inventory->GetFirstFreeSlot(), 4);
+
+	// Setting a slot directly keeps the mask in step
+	Inventory->SetItem(4, Items[4]);
+	TestTrue(TEXT("Full after SetItem"), Inventory->IsFull());
+	Inventory->SetItem(0, nullptr);
+	TestEqual(TEXT("SetItem nullptr frees the slot"), Inventory->GetFirstFreeSlot(), 0);
+	TestTrue(TEXT("Out of range slot"), Inventory->GetItem(UInventoryComponent::NumSlots) == nullptr);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryComponentBroadcastTest, "ProjectMarcus.Inventory.Broadcasts", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FInventoryComponentBroadcastTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryComponentTests;
+
+	FProjectMarcusTestWorld TestWorld;
+	UInventoryComponent* Inventory = CreateInventory(TestWorld.World);
+	UInventoryTestListener* Listener = CreateListener(Inventory);
+
+	Inventory->FlushNotifications();
+	TestEqual(TEXT("Nothing changed, nothing sent"), Listener->GetNumEvents(), 0);
+
+	// One highlight, one event
+	Inventory->HighlightSlot(2);
+	Inventory->FlushNotifications();
+	if (TestEqual(TEXT("Highlight sends one event"), Listener->GetNumEvents(), 1))
+	{
+		TestEqual(TEXT("Highlighted slot"), Listener->HighlightEvents[0].Key, 2);
+		TestTrue(TEXT("Highlight on"), Listener->HighlightEvents[0].Value);
+	}
+	Listener->Reset();
+
+	// Toggling back to where it started within a frame sends nothing
+	Inventory->HighlightSlot(3);
+	Inventory->HighlightSlot(INDEX_NONE);
+	Inventory->HighlightSlot(2);
+	Inventory->FlushNotifications();
+	TestEqual(TEXT("Highlight toggled back sends nothing"), Listener->GetNumEvents(), 0);
+
+	// Moving the highlight is one off and one on
+	Inventory->HighlightSlot(5);
+	Inventory->HighlightSlot(4);
+	Inventory->FlushNotifications();
+	if (TestEqual(TEXT("Moving the highlight sends two events"), Listener->GetNumEvents(), 2))
+	{
+		TestEqual(TEXT("Old slot"), Listener->HighlightEvents[0].Key, 2);
+		TestFalse(TEXT("Old slot off"), Listener->HighlightEvents[0].Value);
+		TestEqual(TEXT("New slot"), Listener->HighlightEvents[1].Key, 4);
+		TestTrue(TEXT("New slot on"), Listener->HighlightEvents[1].Value);
+	}
+	Listener->Reset();
+
+	Inventory->HighlightSlot(INDEX_NONE);
+	Inventory->FlushNotifications();
+	TestEqual(TEXT("Unhighlight sends one event"), Listener->GetNumEvents(), 1);
+	Listener->Reset();
+
+	// Several equips in a frame are one change from the first old slot to the last item
+	AItemBase* First = TestWorld.World->SpawnActor<AItemBase>();
+	AItemBase* Second = TestWorld.World->SpawnActor<AItemBase>();
+	Inventory->AddItem(First);
+	Inventory->AddItem(Second);
+	Inventory->NotifyEquipped(INDEX_NONE, First);
+	Inventory->NotifyEquipped(First->GetInventorySlotIndex(), Second);
+	Inventory->FlushNotifications();
+	if (TestEqual(TEXT("Equips in one frame send one event"), Listener->GetNumEvents(), 1))
+	{
+		TestEqual(TEXT("From the first old slot"), Listener->EquipEvents[0].Key, (int32)INDEX_NONE);
+		TestEqual(TEXT("To the last item's slot"), Listener->EquipEvents[0].Value, Second->GetInventorySlotIndex());
+	}
+	Listener->Reset();
+
+	Inventory->FlushNotifications();
+	TestEqual(TEXT("Flushing again sends nothing"), Listener->GetNumEvents(), 0);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "InventoryTestListener.generated.h"
+
+// Records the UInventoryComponent UI events for the automation tests
+UCLASS(Transient, NotBlueprintable)
+class PROJECTMARCUS_API UInventoryTestListener : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION()
+	void OnEquipItem(int32 CurrentSlotIdx, int32 NewSlotIdx) { EquipEvents.Emplace(CurrentSlotIdx, NewSlotIdx); }
+
+	UFUNCTION()
+	void OnHighlightIcon(int32 SlotIdx, bool bStartAnimation) { HighlightEvents.Emplace(SlotIdx, bStartAnimation); }
+
+	int32 GetNumEvents() const { return EquipEvents.Num() + HighlightEvents.Num(); }
+
+	void Reset()
+	{
+		EquipEvents.Reset();
+		HighlightEvents.Reset();
+	}
+
+	TArray<TPair<int32, int32>> EquipEvents;
+	TArray<TPair<int32, bool>> HighlightEvents;
+};
@@ -0,0 +1,160 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Interactables/ItemCurveTable.h"
+#include "Curves/CurveFloat.h"
+#include "Curves/RichCurve.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ItemCurveTableTests
+{
+	// Shaped like the pickup scale curve, flat then a sharp cubic drop at the end
+	FRichCurve MakeScaleCurve()
+	{
+		FRichCurve Curve;
+		Curve.SetKeyInterpMode(Curve.AddKey(0.f, 1.f), RCIM_Cubic);
+		Curve.SetKeyInterpMode(Curve.AddKey(0.5f, 1.1f), RCIM_Cubic);
+		Curve.SetKeyInterpMode(Curve.AddKey(0.6f, 1.f), RCIM_Cubic);
+		Curve.SetKeyInterpMode(Curve.AddKey(0.7f, 0.f), RCIM_Cubic);
+		Curve.AutoSetTangents();
+		return Curve;
+	}
+
+	// Largest difference between the table and the curve, sampled much finer than the bake checks
+	float MeasureMaxError(const FBakedItemCurve& Baked, const FRichCurve& Curve, float MinTime, float MaxTime)
+	{
+		constexpr int32 NumSamples = 20000;
+		float MaxError = 0.f;
+		for (int32 Idx = 0; Idx <= NumSamples; ++Idx)
+		{
+			const float Time = FMath::Lerp(MinTime, MaxTime, static_cast<float>(Idx) / NumSamples);
+			MaxError = FMath::Max(MaxError, FMath::Abs(Baked.Evaluate(Time).X - Curve.Eval(Time)));
+		}
+		return MaxError;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FItemCurveTableMaxErrorTest, "ProjectMarcus.Items.CurveTable.MaxError", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FItemCurveTableMaxErrorTest::RunTest(const FString& Parameters)
+{
+	using namespace ItemCurveTableTests;
+
+	const FRichCurve Curve = MakeScaleCurve();
+	float MinTime = 0.f;
+	float MaxTime = 0.f;
+	Curve.GetTimeRange(MinTime, MaxTime);
+
+	constexpr float Bound = 0.001f;
+	FBakedItemCurve Baked;
+	Baked.Bake([&Curve](float Time) { return FVector(Curve.Eval(Time), 0.f, 0.f); }, MinTime, MaxTime, 16, 4096, Bound);
+
+	TestTrue(TEXT("Baked"), Baked.IsBaked());
+	TestTrue(TEXT("Reported error is within the bound"), Baked.GetMaxError() <= Bound);
+
+	// The reported error is a measurement, the true error can only be slightly over it
+	const float MeasuredError = MeasureMaxError(Baked, Curve, MinTime, MaxTime);
+	TestTrue(FString::Printf(TEXT("Measured error %f is within the bound"), MeasuredError), MeasuredError <= Bound * 1.05f);
+	TestTrue(FString::Printf(TEXT("Reported error %f matches the measured error %f"), Baked.GetMaxError(), MeasuredError), MeasuredError <= Baked.GetMaxError() * 1.05f);
+
+	// Ends are sampled exactly and times outside the range clamp to them
+	TestEqual(TEXT("Start"), Baked.Evaluate(MinTime).X, Curve.Eval(MinTime), KINDA_SMALL_NUMBER);
+	TestEqual(TEXT("End"), Baked.Evaluate(MaxTime).X, Curve.Eval(MaxTime), KINDA_SMALL_NUMBER);
+	TestEqual(TEXT("Before start"), Baked.Evaluate(MinTime - 1.f).X, Curve.Eval(MinTime), KINDA_SMALL_NUMBER);
+	TestEqual(TEXT("Past end"), Baked.Evaluate(MaxTime + 1.f).X, Curve.Eval(MaxTime), KINDA_SMALL_NUMBER);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FItemCurveTableResolutionCapTest, "ProjectMarcus.Items.CurveTable.ResolutionCap", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FItemCurveTableResolutionCapTest::RunTest(const FString& Parameters)
+{
+	using namespace ItemCurveTableTests;
+
+	const FRichCurve Curve = MakeScaleCurve();
+	float MinTime = 0.f;
+	float MaxTime = 0.f;
+	Curve.GetTimeRange(MinTime, MaxTime);
+
+	// An unreachable bound stops at the max resolution and reports what it got to
+	FBakedItemCurve Baked;
+	Baked.Bake([&Curve](float Time) { return FVector(Curve.Eval(Time), 0.f, 0.f); }, MinTime, MaxTime, 4, 8, 0.f);
+
+	TestTrue(TEXT("Error over the bound is reported"), Baked.GetMaxError() > 0.f);
+	const float MeasuredError = MeasureMaxError(Baked, Curve, MinTime, MaxTime);
+	TestTrue(FString::Printf(TEXT("Reported error %f matches the measured error %f"), Baked.GetMaxError(), MeasuredError), MeasuredError <= Baked.GetMaxError() * 1.1f);
+
+	Baked.Reset();
+	TestFalse(TEXT("Reset"), Baked.IsBaked());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FItemCurveTableBenchmarkTest, "ProjectMarcus.Items.CurveTable.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FItemCurveTableBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace ItemCurveTableTests;
+
+	// A few keys like the shipped curves, and a heavily keyed one where the raw curve's key search costs more
+	const int32 KeyCounts[] = { 4, 64 };
+	constexpr int32 NumSamples = 1000000;
+
+	for (int32 NumKeys : KeyCounts)
+	{
+		UCurveFloat* Curve = NewObject<UCurveFloat>();
+		if (NumKeys == 4)
+		{
+			Curve->FloatCurve = MakeScaleCurve();
+		}
+		else
+		{
+			for (int32 Key = 0; Key < NumKeys; ++Key)
+			{
+				const float Time = static_cast<float>(Key) / (NumKeys - 1);
+				Curve->FloatCurve.SetKeyInterpMode(Curve->FloatCurve.AddKey(Time, FMath::Sin(Time * 4.f * PI)), RCIM_Cubic);
+			}
+			Curve->FloatCurve.AutoSetTangents();
+		}
+
+		UItemCurveTable* Table = NewObject<UItemCurveTable>();
+		Table->Bake(nullptr, Curve, nullptr, nullptr);
+		if (!TestTrue(TEXT("Baked"), Table->HasScale()))
+		{
+			return false;
+		}
+
+		float MinTime = 0.f;
+		float MaxTime = 0.f;
+		Curve->GetTimeRange(MinTime, MaxTime);
+		const float TimeStep = (MaxTime - MinTime) / NumSamples;
+
+		// Summed so the loops can't be optimised away, and compared so the table is known to be answering the same thing
+		double RawSum = 0.0;
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Idx = 0; Idx < NumSamples; ++Idx)
+		{
+			RawSum += Curve->GetFloatValue(MinTime + Idx * TimeStep);
+		}
+		const double RawMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		double BakedSum = 0.0;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Idx = 0; Idx < NumSamples; ++Idx)
+		{
+			BakedSum += Table->EvaluateScale(MinTime + Idx * TimeStep);
+		}
+		const double BakedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		AddInfo(FString::Printf(TEXT("%d keys, %d samples: curve %.2fms (%.1fns each), baked table %.2fms (%.1fns each), max error %f"),
+			NumKeys, NumSamples, RawMs, RawMs * 1000000.0 / NumSamples, BakedMs, BakedMs * 1000000.0 / NumSamples, Table->GetBakedMaxError()));
+
+		TestTrue(FString::Printf(TEXT("%d keys: mean difference within the bake error"), NumKeys), FMath::Abs(RawSum - BakedSum) / NumSamples <= Table->GetBakedMaxError() + KINDA_SMALL_NUMBER);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Character/ItemFocusScoring.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ItemFocusScoringTests
+{
+	// Looking down +X from the origin, 1000 units of range
+	FItemFocusParams MakeParams(int32 CurrentFocusIndex = INDEX_NONE)
+	{
+		FItemFocusParams Params;
+		Params.ViewOrigin = FVector::ZeroVector;
+		Params.ViewDir = FVector::ForwardVector;
+		Params.LookThreshold = 0.99f;
+		Params.DistanceWeight = 0.005f;
+		Params.MaxDistance = 1000.f;
+		Params.HysteresisBand = 0.003f;
+		Params.CurrentFocusIndex = CurrentFocusIndex;
+		return Params;
+	}
+
+	FItemFocusCandidates MakeCandidates(std::initializer_list<FVector> Locations)
+	{
+		FItemFocusCandidates Candidates;
+		for (const FVector& Location : Locations)
+		{
+			Candidates.Add(Location);
+		}
+		Candidates.Finalize();
+		return Candidates;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FItemFocusScoringThresholdTest, "ProjectMarcus.Items.FocusScoring.Threshold", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FItemFocusScoringThresholdTest::RunTest(const FString& Parameters)
+{
+	using namespace ItemFocusScoringTests;
+
+	TestEqual(TEXT("No candidates"), ItemFocusScoring::FindBestCandidate(MakeCandidates({}), MakeParams()), (int32)INDEX_NONE);
+
+	// cos ~0.981, under the 0.99 threshold
+	TestEqual(TEXT("Nothing under the crosshair"), ItemFocusScoring::FindBestCandidate(MakeCandidates({ FVector(500.f, 100.f, 0.f) }), MakeParams()), (int32)INDEX_NONE);
+
+	// cos ~0.989 is under the threshold but inside the hysteresis band, only the focused item gets to keep it
+	const FItemFocusCandidates NearMiss = MakeCandidates({ FVector(500.f, 75.f, 0.f) });
+	TestEqual(TEXT("Unfocused item inside the band"), ItemFocusScoring::FindBestCandidate(NearMiss, MakeParams()), (int32)INDEX_NONE);
+	TestEqual(TEXT("Focused item inside the band"), ItemFocusScoring::FindBestCandidate(NearMiss, MakeParams(0)), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FItemFocusScoringOrderTest, "ProjectMarcus.Items.FocusScoring.Order", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FItemFocusScoringOrderTest::RunTest(const FString& Parameters)
+{
+	using namespace ItemFocusScoringTests;
+
+	// Lined up on the ray, the closer one wins on the distance penalty
+	TestEqual(TEXT("Closer item on the same ray"), ItemFocusScoring::FindBestCandidate(MakeCandidates({ FVector(500.f, 0.f, 0.f), FVector(250.f, 0.f, 0.f) }), MakeParams()), 1);
+
+	// Same distance, the one nearer the ray wins
+	TestEqual(TEXT("Item nearer the ray"), ItemFocusScoring::FindBestCandidate(MakeCandidates({ FVector(500.f, 30.f, 0.f), FVector(500.f, 0.f, 0.f) }), MakeParams()), 1);
+
+	// Exact ties keep the first candidate
+	TestEqual(TEXT("Exact tie"), ItemFocusScoring::FindBestCandidate(MakeCandidates({ FVector(500.f, 0.f, 0.f), FVector(500.f, 0.f, 0.f) }), MakeParams()), 0);
+
+	// Best candidate in the second group of 4 lanes, with padding lanes after it
+	TestEqual(TEXT("Best candidate past the first 4 lanes"), ItemFocusScoring::FindBestCandidate(MakeCandidates({
+		FVector(500.f, 100.f, 0.f), FVector(500.f, 40.f, 0.f), FVector(500.f, -40.f, 0.f), FVector(500.f, 0.f, 40.f), FVector(400.f, 0.f, 0.f) }), MakeParams()), 4);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FItemFocusScoringHysteresisTest, "ProjectMarcus.Items.FocusScoring.Hysteresis", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FItemFocusScoringHysteresisTest::RunTest(const FString& Parameters)
+{
+	using namespace ItemFocusScoringTests;
+
+	// Scores ~0.9957 (slightly off the ray) and 0.9975 (on it), less than the band apart
+	const FItemFocusCandidates Candidates = MakeCandidates({ FVector(500.f, 30.f, 0.f), FVector(500.f, 0.f, 0.f) });
+	TestEqual(TEXT("Nothing focused, the better score wins"), ItemFocusScoring::FindBestCandidate(Candidates, MakeParams()), 1);
+	TestEqual(TEXT("Focused item keeps focus against a marginally better one"), ItemFocusScoring::FindBestCandidate(Candidates, MakeParams(0)), 0);
+
+	// A challenger clearly better than the band takes over
+	const FItemFocusCandidates Clear = MakeCandidates({ FVector(500.f, 60.f, 0.f), FVector(200.f, 0.f, 0.f) });
+	TestEqual(TEXT("Clearly better challenger"), ItemFocusScoring::FindBestCandidate(Clear, MakeParams(0)), 1);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,133 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Interactables/ItemSpatialSubsystem.h"
+#include "ProjectMarcus/Interactables/ItemBase.h"
+#include "ProjectMarcus/Tests/ProjectMarcusTestWorld.h"
+#include "Components/SphereComponent.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ItemSpatialBenchmarkTests
+{
+	// Matches the character's ItemPickupRange
+	constexpr float PickupRange = 250.f;
+	// Items are scattered over a fixed 200m square, so more items means a denser map
+	constexpr float HalfExtent = 10000.f;
+	constexpr int32 NumQueries = 1000;
+
+	USphereComponent* SpawnSphereActor(UWorld* World, const FVector& Location, float Radius)
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+		USphereComponent* Sphere = NewObject<USphereComponent>(Actor);
+		Sphere->InitSphereRadius(Radius);
+		Sphere->SetCollisionResponseToAllChannels(ECR_Overlap);
+		Sphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		Sphere->SetGenerateOverlapEvents(true);
+		Actor->SetRootComponent(Sphere);
+		Sphere->RegisterComponent();
+		Sphere->SetWorldLocation(Location);
+		return Sphere;
+	}
+
+	TArray<FVector> MakeLocations(FRandomStream& Random, int32 Num)
+	{
+		TArray<FVector> Locations;
+		Locations.Reserve(Num);
+		for (int32 Idx = 0; Idx < Num; ++Idx)
+		{
+			Locations.Emplace(Random.FRandRange(-HalfExtent, HalfExtent), Random.FRandRange(-HalfExtent, HalfExtent), 0.f);
+		}
+		return Locations;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FItemSpatialBenchmarkTest, "ProjectMarcus.Items.Spatial.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FItemSpatialBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace ItemSpatialBenchmarkTests;
+
+	const int32 ItemCounts[] = { 100, 1000, 10000 };
+
+	for (int32 NumItems : ItemCounts)
+	{
+		FRandomStream Random(NumItems);
+		const TArray<FVector> ItemLocations = MakeLocations(Random, NumItems);
+		const TArray<FVector> QueryLocations = MakeLocations(Random, NumQueries);
+
+		// Old path, every item carried an overlap-all trigger and moving the character updated overlaps against them.
+		// A 1cm querier against PickupRange - 1 triggers finds the same items as the grid's PickupRange query
+		int32 OverlapFound = 0;
+		double OverlapBuildMs = 0.0;
+		double OverlapQueryMs = 0.0;
+		{
+			FProjectMarcusTestWorld TestWorld;
+			double StartTime = FPlatformTime::Seconds();
+			for (const FVector& Location : ItemLocations)
+			{
+				SpawnSphereActor(TestWorld.World, Location, PickupRange - 1.f);
+			}
+			OverlapBuildMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+			USphereComponent* Querier = SpawnSphereActor(TestWorld.World, FVector(0.f, 0.f, 10000.f), 1.f);
+			TArray<AActor*> Overlapping;
+			StartTime = FPlatformTime::Seconds();
+			for (const FVector& Location : QueryLocations)
+			{
+				Querier->SetWorldLocation(Location);
+				Querier->GetOverlappingActors(Overlapping);
+				OverlapFound += Overlapping.Num();
+			}
+			OverlapQueryMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		}
+
+		// New path, items sit in the spatial grid and the character queries it
+		int32 GridFound = 0;
+		double GridBuildMs = 0.0;
+		double GridQueryMs = 0.0;
+		{
+			FProjectMarcusTestWorld TestWorld;
+			UItemSpatialSubsystem* ItemIndex = TestWorld.World->GetSubsystem<UItemSpatialSubsystem>();
+			if (!TestNotNull(TEXT("Subsystem"), ItemIndex))
+			{
+				return false;
+			}
+
+			TArray<AItemBase*> Items;
+			Items.Reserve(NumItems);
+			for (const FVector& Location : ItemLocations)
+			{
+				Items.Add(TestWorld.World->SpawnActor<AItemBase>(Location, FRotator::ZeroRotator));
+			}
+
+			double StartTime = FPlatformTime::Seconds();
+			for (AItemBase* Item : Items)
+			{
+				ItemIndex->RegisterItem(Item);
+			}
+			GridBuildMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+			TestEqual(TEXT("Every item indexed"), ItemIndex->GetNumIndexedItems(), NumItems);
+
+			TArray<AItemBase*> InRange;
+			StartTime = FPlatformTime::Seconds();
+			for (const FVector& Location : QueryLocations)
+			{
+				InRange.Reset();
+				ItemIndex->QueryItemsInRadius(Location, PickupRange, InRange);
+				GridFound += InRange.Num();
+			}
+			GridQueryMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		}
+
+		AddInfo(FString::Printf(TEXT("%d items: overlap build %.2fms, %.2fus/query (%d found) | grid build %.2fms, %.2fus/query (%d found)"),
+			NumItems, OverlapBuildMs, OverlapQueryMs * 1000.0 / NumQueries, OverlapFound, GridBuildMs, GridQueryMs * 1000.0 / NumQueries, GridFound));
+
+		// Both paths answer the same question, allow for items right on the edge of the range
+		TestTrue(FString::Printf(TEXT("%d items: grid found %d, overlaps found %d"), NumItems, GridFound, OverlapFound), FMath::Abs(GridFound - OverlapFound) <= FMath::Max(2, OverlapFound / 100));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
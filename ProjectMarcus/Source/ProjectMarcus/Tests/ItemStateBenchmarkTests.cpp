@@ -0,0 +1,173 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Interactables/ItemBase.h"
+#include "ProjectMarcus/Interactables/ItemSpatialSubsystem.h"
+#include "ProjectMarcus/Tests/ProjectMarcusTestWorld.h"
+#include "Components/SphereComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ItemStateBenchmarkTests
+{
+	constexpr int32 NumItems = 1000;
+	constexpr int32 NumCycles = 10;
+
+	// Dropped, picked up, equipped, thrown
+	const EItemState Cycle[] = { EItemState::EIS_PickupWaiting, EItemState::EIS_PickUp, EItemState::EIS_Equipped, EItemState::EIS_Falling };
+
+	// An item's mesh and, for the old path, its pickup trigger
+	struct FBenchmarkItem
+	{
+		UStaticMeshComponent* Mesh = nullptr;
+		USphereComponent* Trigger = nullptr;
+		AItemBase* Item = nullptr;
+	};
+
+	// The switch UpdateToState had before the state profiles, every setter called on every transition
+	void ApplyStateOld(const FBenchmarkItem& BenchmarkItem, EItemState State)
+	{
+		UStaticMeshComponent* Mesh = BenchmarkItem.Mesh;
+		USphereComponent* Trigger = BenchmarkItem.Trigger;
+
+		Mesh->SetVisibility(true);
+		if (State == EItemState::EIS_Falling)
+		{
+			Mesh->SetSimulatePhysics(true);
+			Mesh->SetEnableGravity(true);
+			Mesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
+			Mesh->SetCollisionResponseToChannel(ECollisionChannel::ECC_WorldStatic, ECollisionResponse::ECR_Block);
+			Mesh->SetCollisionEnabled(ECollisionEnabled::PhysicsOnly);
+		}
+		else
+		{
+			Mesh->SetSimulatePhysics(false);
+			Mesh->SetEnableGravity(false);
+			Mesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
+			Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		}
+
+		if (State == EItemState::EIS_PickupWaiting)
+		{
+			Trigger->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Overlap);
+			Trigger->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		}
+		else
+		{
+			Trigger->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
+			Trigger->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		}
+	}
+
+	// What UpdateToState does now, the profile diffed against the mesh and the pickup index in place of the trigger
+	void ApplyStateNew(const FBenchmarkItem& BenchmarkItem, EItemState State, UItemSpatialSubsystem* ItemIndex)
+	{
+		const FItemStateProfile& Profile = GetDefault<AItemBase>()->GetStateProfile(State);
+		AItemBase::ApplyStateProfile(BenchmarkItem.Mesh, Profile);
+		if (Profile.bProximityTrigger)
+		{
+			ItemIndex->RegisterItem(BenchmarkItem.Item);
+		}
+		else
+		{
+			ItemIndex->UnregisterItem(BenchmarkItem.Item);
+		}
+	}
+
+	TArray<FBenchmarkItem> SpawnItems(UWorld* World, UStaticMesh* Cube)
+	{
+		TArray<FBenchmarkItem> Items;
+		Items.Reserve(NumItems);
+		for (int32 Idx = 0; Idx < NumItems; ++Idx)
+		{
+			const FVector Location((Idx % 40) * 200.f, (Idx / 40) * 200.f, 0.f);
+
+			FBenchmarkItem& BenchmarkItem = Items.AddDefaulted_GetRef();
+			BenchmarkItem.Item = World->SpawnActor<AItemBase>(Location, FRotator::ZeroRotator);
+
+			AActor* Actor = World->SpawnActor<AActor>();
+			BenchmarkItem.Mesh = NewObject<UStaticMeshComponent>(Actor);
+			BenchmarkItem.Mesh->SetStaticMesh(Cube);
+			Actor->SetRootComponent(BenchmarkItem.Mesh);
+			BenchmarkItem.Mesh->RegisterComponent();
+			BenchmarkItem.Mesh->SetWorldLocation(Location);
+
+			BenchmarkItem.Trigger = NewObject<USphereComponent>(Actor);
+			BenchmarkItem.Trigger->SetupAttachment(BenchmarkItem.Mesh);
+			BenchmarkItem.Trigger->RegisterComponent();
+		}
+		return Items;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FItemStateBenchmarkTest, "ProjectMarcus.Items.State.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FItemStateBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace ItemStateBenchmarkTests;
+
+	// Needs a mesh with a body so the physics and collision changes do real work
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!TestNotNull(TEXT("Cube mesh"), Cube))
+	{
+		return false;
+	}
+
+	double OldMs = 0.0;
+	{
+		FProjectMarcusTestWorld TestWorld;
+		const TArray<FBenchmarkItem> Items = SpawnItems(TestWorld.World, Cube);
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 CycleIdx = 0; CycleIdx < NumCycles; ++CycleIdx)
+		{
+			for (EItemState State : Cycle)
+			{
+				for (const FBenchmarkItem& BenchmarkItem : Items)
+				{
+					ApplyStateOld(BenchmarkItem, State);
+				}
+			}
+		}
+		OldMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	}
+
+	double NewMs = 0.0;
+	{
+		FProjectMarcusTestWorld TestWorld;
+		UItemSpatialSubsystem* ItemIndex = TestWorld.World->GetSubsystem<UItemSpatialSubsystem>();
+		if (!TestNotNull(TEXT("Subsystem"), ItemIndex))
+		{
+			return false;
+		}
+		const TArray<FBenchmarkItem> Items = SpawnItems(TestWorld.World, Cube);
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 CycleIdx = 0; CycleIdx < NumCycles; ++CycleIdx)
+		{
+			for (EItemState State : Cycle)
+			{
+				for (const FBenchmarkItem& BenchmarkItem : Items)
+				{
+					ApplyStateNew(BenchmarkItem, State, ItemIndex);
+				}
+			}
+		}
+		NewMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		// Ends on falling, the physics setup made it through the profile
+		TestTrue(TEXT("Falling simulates physics"), Items[0].Mesh->IsSimulatingPhysics());
+		TestEqual(TEXT("Falling uses the falling profile"), Items[0].Mesh->GetCollisionProfileName(), FItemStateProfile::FallingCollisionProfile);
+		TestEqual(TEXT("Nothing left in the pickup index"), ItemIndex->GetNumIndexedItems(), 0);
+	}
+
+	const int32 NumTransitions = NumItems * NumCycles * UE_ARRAY_COUNT(Cycle);
+	AddInfo(FString::Printf(TEXT("%d transitions: individual setters %.2fms (%.2fus each), state profiles %.2fms (%.2fus each)"),
+		NumTransitions, OldMs, OldMs * 1000.0 / NumTransitions, NewMs, NewMs * 1000.0 / NumTransitions));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Throwaway game world for automation tests, so subsystems and actors are created the way they are in game.
+// Play isn't started unless the test calls BeginPlay
+struct FProjectMarcusTestWorld
+{
+	UWorld* World = nullptr;
+
+	FProjectMarcusTestWorld()
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false);
+		GEngine->CreateNewWorldContext(EWorldType::Game).SetCurrentWorld(World);
+	}
+
+	// Starts play without a game mode, so subsystems see OnWorldBeginPlay and actors spawned from here on get BeginPlay
+	void BeginPlay()
+	{
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+		World->GetWorldSettings()->NotifyBeginPlay();
+	}
+
+	// One full frame, tick functions, timers and tickable objects
+	void Tick(float DeltaTime)
+	{
+		World->Tick(LEVELTICK_All, DeltaTime);
+	}
+
+	~FProjectMarcusTestWorld()
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+};
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/Combat/WeaponFireScheduler.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace WeaponFireSchedulerTests
+{
+	const float FrameRates[] = { 10.f, 24.f, 30.f, 60.f, 120.f, 144.f, 240.f };
+
+	// Holds the trigger for Duration at a fixed frame time, returns the shots delivered
+	int32 HoldTrigger(FWeaponFireScheduler& Scheduler, float DeltaTime, float Duration, bool& bOutAgesInFrame)
+	{
+		bOutAgesInFrame = true;
+		int32 NumShots = 0;
+		const int32 NumFrames = FMath::RoundToInt(Duration / DeltaTime);
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			FWeaponFireScheduler::FShotAges ShotAges;
+			NumShots += Scheduler.Advance(DeltaTime, 64, ShotAges);
+			for (float Age : ShotAges)
+			{
+				bOutAgesInFrame &= Age >= 0.f && Age <= DeltaTime;
+			}
+		}
+		return NumShots;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWeaponFireSchedulerRateTest, "ProjectMarcus.Combat.FireScheduler.Rate", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FWeaponFireSchedulerRateTest::RunTest(const FString& Parameters)
+{
+	using namespace WeaponFireSchedulerTests;
+
+	// One shot a frame at 10Hz, several a frame at 10Hz for the fast weapon
+	const float FireIntervals[] = { 0.1f, 1.f / 30.f };
+	constexpr float Duration = 10.f;
+
+	for (float FireInterval : FireIntervals)
+	{
+		for (float FrameRate : FrameRates)
+		{
+			FWeaponFireScheduler Scheduler;
+			Scheduler.SetFireInterval(FireInterval);
+
+			bool bAgesInFrame = false;
+			const int32 NumShots = HoldTrigger(Scheduler, 1.f / FrameRate, Duration, bAgesInFrame);
+			const float ExpectedShots = Duration / FireInterval;
+
+			TestTrue(FString::Printf(TEXT("%.0f shots/s at %.0fHz delivered %d shots in %.0fs"), 1.f / FireInterval, FrameRate, NumShots, Duration), FMath::Abs(NumShots - ExpectedShots) <= 1.f);
+			TestTrue(FString::Printf(TEXT("%.0f shots/s at %.0fHz shot ages are inside their frame"), 1.f / FireInterval, FrameRate), bAgesInFrame);
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWeaponFireSchedulerCatchUpTest, "ProjectMarcus.Combat.FireScheduler.CatchUp", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FWeaponFireSchedulerCatchUpTest::RunTest(const FString& Parameters)
+{
+	using namespace WeaponFireSchedulerTests;
+
+	constexpr float FireInterval = 0.1f;
+	constexpr float MaxCatchUpTime = 0.5f;
+	constexpr float Duration = 5.f;
+
+	for (float FrameRate : FrameRates)
+	{
+		FWeaponFireScheduler Scheduler;
+		Scheduler.SetFireInterval(FireInterval);
+		Scheduler.SetMaxCatchUpTime(MaxCatchUpTime);
+
+		bool bAgesInFrame = false;
+		int32 NumShots = HoldTrigger(Scheduler, 1.f / FrameRate, Duration, bAgesInFrame);
+
+		// A 2s hitch only pays out the shot owed plus MaxCatchUpTime worth, not 20
+		FWeaponFireScheduler::FShotAges ShotAges;
+		const int32 HitchShots = Scheduler.Advance(2.f, 64, ShotAges);
+		const float ExpectedHitchShots = (FireInterval + MaxCatchUpTime) / FireInterval;
+		TestTrue(FString::Printf(TEXT("%.0fHz hitch delivered %d shots"), FrameRate, HitchShots), FMath::Abs(HitchShots - ExpectedHitchShots) <= 1.f);
+
+		// Then back to the normal rate
+		NumShots += HoldTrigger(Scheduler, 1.f / FrameRate, Duration, bAgesInFrame);
+		TestTrue(FString::Printf(TEXT("%.0fHz delivered %d shots around the hitch"), FrameRate, NumShots), FMath::Abs(NumShots - 2.f * Duration / FireInterval) <= 1.f);
+		TestTrue(FString::Printf(TEXT("%.0fHz shot ages are inside their frame"), FrameRate), bAgesInFrame);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,242 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/UI/HUDMarkerComponent.h"
+#include "ProjectMarcus/UI/HitNumberWidget.h"
+#include "ProjectMarcus/UI/HealthBarWidget.h"
+#include "ProjectMarcus/ProjectMarcus.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/GameViewportClient.h"
+#include "SceneView.h"
+
+DECLARE_CYCLE_STAT(TEXT("HUD Marker Update"), STAT_HUDMarkerUpdate, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HUD Markers Projected"), STAT_HUDMarkersProjected, STATGROUP_ProjectMarcus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HUD Hit Numbers Merged"), STAT_HUDHitNumbersMerged, STATGROUP_ProjectMarcus);
+
+UHUDMarkerComponent::UHUDMarkerComponent()
+{
+	// Driven by the owning player controller after the camera updates
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+UHUDMarkerComponent* UHUDMarkerComponent::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+	return PC ? PC->FindComponentByClass<UHUDMarkerComponent>() : nullptr;
+}
+
+void UHUDMarkerComponent::AddHitNumber(AActor* Anchor, int32 Damage, const FVector& HitLocation, bool bHeadshot)
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	// Merge with a number that just popped on the same anchor
+	for (FHitNumberMarker& Marker : HitNumbers)
+	{
+		if (Marker.Anchor.Get() == Anchor && Now - Marker.SpawnTime <= HitNumberMergeWindow)
+		{
+			Marker.Damage += Damage;
+			Marker.bHeadshot |= bHeadshot;
+			Marker.ExpireTime = Now + HitNumberLifetime;
+			Marker.Widget->SetHitNumber(Marker.Damage, Marker.bHeadshot);
+			INC_DWORD_STAT(STAT_HUDHitNumbersMerged);
+			return;
+		}
+	}
+
+	UHitNumberWidget* Widget = AcquireWidget(HitNumberWidgetClass, FreeHitNumbers);
+	if (Widget == nullptr)
+	{
+		return;
+	}
+
+	FHitNumberMarker& Marker = HitNumbers.AddDefaulted_GetRef();
+	Marker.Anchor = Anchor;
+	Marker.Widget = Widget;
+	Marker.WorldLocation = HitLocation;
+	Marker.SpawnTime = Now;
+	Marker.ExpireTime = Now + HitNumberLifetime;
+	Marker.Damage = Damage;
+	Marker.bHeadshot = bHeadshot;
+	Widget->SetHitNumber(Damage, bHeadshot);
+}
+
+void UHUDMarkerComponent::ShowHealthBar(AActor* Anchor, float HealthPercent, float Duration)
+{
+	if (Anchor == nullptr)
+	{
+		return;
+	}
+
+	FHealthBarMarker* Marker = FindHealthBar(Anchor);
+	if (Marker == nullptr)
+	{
+		UHealthBarWidget* Widget = AcquireWidget(HealthBarWidgetClass, FreeHealthBars);
+		if (Widget == nullptr)
+		{
+			return;
+		}
+
+		Marker = &HealthBars.AddDefaulted_GetRef();
+		Marker->Anchor = Anchor;
+		Marker->Widget = Widget;
+	}
+
+	Marker->ExpireTime = GetWorld()->GetTimeSeconds() + Duration;
+	Marker->Widget->SetHealthPercent(HealthPercent);
+}
+
+void UHUDMarkerComponent::SetHealthBarPercent(AActor* Anchor, float HealthPercent)
+{
+	if (FHealthBarMarker* Marker = FindHealthBar(Anchor))
+	{
+		Marker->Widget->SetHealthPercent(HealthPercent);
+	}
+}
+
+void UHUDMarkerComponent::HideHealthBar(AActor* Anchor)
+{
+	const int32 Index = HealthBars.IndexOfByPredicate([Anchor](const FHealthBarMarker& Marker) { return Marker.Anchor.Get() == Anchor; });
+	if (Index != INDEX_NONE)
+	{
+		RemoveHealthBarAt(Index);
+	}
+}
+
+void UHUDMarkerComponent::UpdateMarkers()
+{
+	SCOPE_CYCLE_COUNTER(STAT_HUDMarkerUpdate);
+
+	if (HitNumbers.Num() == 0 && HealthBars.Num() == 0)
+	{
+		return;
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	// Expire first so we don't project anything we're about to hide
+	for (int32 Idx = HitNumbers.Num() - 1; Idx >= 0; --Idx)
+	{
+		if (Now >= HitNumbers[Idx].ExpireTime)
+		{
+			SetWidgetOnScreen(HitNumbers[Idx].Widget, HitNumbers[Idx].bOnScreen, false);
+			FreeHitNumbers.Add(HitNumbers[Idx].Widget);
+			HitNumbers.RemoveAtSwap(Idx, 1, false);
+		}
+	}
+	for (int32 Idx = HealthBars.Num() - 1; Idx >= 0; --Idx)
+	{
+		if (Now >= HealthBars[Idx].ExpireTime || !HealthBars[Idx].Anchor.IsValid())
+		{
+			RemoveHealthBarAt(Idx);
+		}
+	}
+
+	// One view-projection matrix for every anchor this frame
+	const APlayerController* PC = Cast<APlayerController>(GetOwner());
+	ULocalPlayer* LocalPlayer = PC ? PC->GetLocalPlayer() : nullptr;
+	if (LocalPlayer == nullptr || LocalPlayer->ViewportClient == nullptr)
+	{
+		return;
+	}
+
+	FSceneViewProjectionData ProjectionData;
+	if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, eSSP_FULL, ProjectionData))
+	{
+		return;
+	}
+
+	const FMatrix ViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix();
+	const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+	const FBox2D ScreenBounds(
+		FVector2D(ViewRect.Min) - FVector2D(ScreenEdgeMargin),
+		FVector2D(ViewRect.Max) + FVector2D(ScreenEdgeMargin));
+
+	auto ProjectMarker = [&](const FVector& WorldLocation, UUserWidget* Widget, bool& bOnScreen)
+	{
+		FVector2D ScreenPosition;
+		const bool bProjected = FSceneView::ProjectWorldToScreen(WorldLocation, ViewRect, ViewProjectionMatrix, ScreenPosition);
+		const bool bNewOnScreen = bProjected && ScreenBounds.IsInside(ScreenPosition);
+		if (bNewOnScreen)
+		{
+			Widget->SetPositionInViewport(ScreenPosition);
+		}
+		SetWidgetOnScreen(Widget, bOnScreen, bNewOnScreen);
+	};
+
+	for (FHitNumberMarker& Marker : HitNumbers)
+	{
+		ProjectMarker(Marker.WorldLocation, Marker.Widget, Marker.bOnScreen);
+	}
+	for (FHealthBarMarker& Marker : HealthBars)
+	{
+		ProjectMarker(Marker.Anchor->GetActorLocation() + FVector(0.f, 0.f, HealthBarHeight), Marker.Widget, Marker.bOnScreen);
+	}
+
+	INC_DWORD_STAT_BY(STAT_HUDMarkersProjected, HitNumbers.Num() + HealthBars.Num());
+}
+
+void UHUDMarkerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (UUserWidget* Widget : CreatedWidgets)
+	{
+		if (Widget)
+		{
+			Widget->RemoveFromParent();
+		}
+	}
+	CreatedWidgets.Empty();
+	FreeHitNumbers.Empty();
+	FreeHealthBars.Empty();
+	HitNumbers.Empty();
+	HealthBars.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+template<class T>
+T* UHUDMarkerComponent::AcquireWidget(TSubclassOf<T> WidgetClass, TArray<T*>& FreeList)
+{
+	if (FreeList.Num() > 0)
+	{
+		return FreeList.Pop(false);
+	}
+
+	APlayerController* PC = Cast<APlayerController>(GetOwner());
+	if (WidgetClass == nullptr || PC == nullptr)
+	{
+		return nullptr;
+	}
+
+	// Added once and left in the viewport, only visibility changes after this
+	T* Widget = CreateWidget<T>(PC, WidgetClass);
+	if (Widget)
+	{
+		Widget->SetVisibility(ESlateVisibility::Collapsed);
+		Widget->AddToViewport();
+		CreatedWidgets.Add(Widget);
+	}
+	return Widget;
+}
+
+void UHUDMarkerComponent::SetWidgetOnScreen(UUserWidget* Widget, bool& bOnScreen, bool bNewOnScreen)
+{
+	if (bOnScreen != bNewOnScreen)
+	{
+		bOnScreen = bNewOnScreen;
+		Widget->SetVisibility(bOnScreen ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
+	}
+}
+
+UHUDMarkerComponent::FHealthBarMarker* UHUDMarkerComponent::FindHealthBar(const AActor* Anchor)
+{
+	return HealthBars.FindByPredicate([Anchor](const FHealthBarMarker& Marker) { return Marker.Anchor.Get() == Anchor; });
+}
+
+void UHUDMarkerComponent::RemoveHealthBarAt(int32 Index)
+{
+	FHealthBarMarker& Marker = HealthBars[Index];
+	SetWidgetOnScreen(Marker.Widget, Marker.bOnScreen, false);
+	FreeHealthBars.Add(Marker.Widget);
+	HealthBars.RemoveAtSwap(Index, 1, false);
+}
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "HUDMarkerComponent.generated.h"
+
+/**
+ * Owns every world anchored HUD widget (hit numbers, enemy health bars) for a local player.
+ * Widgets are pooled and stay in the viewport, collapsed while unused. Once per frame, after the camera has updated,
+ * every anchor is projected with the same view-projection matrix and anything off screen is collapsed.
+ */
+UCLASS(ClassGroup = (UI), meta = (BlueprintSpawnableComponent))
+class PROJECTMARCUS_API UHUDMarkerComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UHUDMarkerComponent();
+
+	// Marker component of the first local player in the world, if there is one
+	static UHUDMarkerComponent* Get(const UObject* WorldContextObject);
+
+	// Shows Damage at HitLocation. Hits on the same anchor within HitNumberMergeWindow add onto the existing number
+	void AddHitNumber(AActor* Anchor, int32 Damage, const FVector& HitLocation, bool bHeadshot);
+
+	// Shows (or refreshes) the health bar over Anchor for Duration seconds
+	void ShowHealthBar(AActor* Anchor, float HealthPercent, float Duration);
+
+	// Updates the bar over Anchor if one is showing
+	void SetHealthBarPercent(AActor* Anchor, float HealthPercent);
+
+	void HideHealthBar(AActor* Anchor);
+
+	// Expires old markers and re-projects the rest. Called by the owning player controller right after its camera updates
+	void UpdateMarkers();
+
+protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	struct FHitNumberMarker
+	{
+		TWeakObjectPtr<AActor> Anchor;
+		class UHitNumberWidget* Widget = nullptr;
+		FVector WorldLocation = FVector::ZeroVector;
+		float SpawnTime = 0.f;
+		float ExpireTime = 0.f;
+		int32 Damage = 0;
+		bool bHeadshot = false;
+		bool bOnScreen = false;
+	};
+
+	struct FHealthBarMarker
+	{
+		TWeakObjectPtr<AActor> Anchor;
+		class UHealthBarWidget* Widget = nullptr;
+		float ExpireTime = 0.f;
+		bool bOnScreen = false;
+	};
+
+	template<class T>
+	T* AcquireWidget(TSubclassOf<T> WidgetClass, TArray<T*>& FreeList);
+
+	static void SetWidgetOnScreen(class UUserWidget* Widget, bool& bOnScreen, bool bNewOnScreen);
+
+	FHealthBarMarker* FindHealthBar(const AActor* Anchor);
+
+	void RemoveHealthBarAt(int32 Index);
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Numbers", meta = (AllowPrivateAccess = "true"))
+	TSubclassOf<UHitNumberWidget> HitNumberWidgetClass;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Numbers", meta = (AllowPrivateAccess = "true"))
+	float HitNumberLifetime = 1.5f;
+
+	// Hits on the same anchor this close together show up as one number
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Numbers", meta = (AllowPrivateAccess = "true"))
+	float HitNumberMergeWindow = 0.2f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Health Bars", meta = (AllowPrivateAccess = "true"))
+	TSubclassOf<UHealthBarWidget> HealthBarWidgetClass;
+
+	// Height of the health bar above the anchor actors location
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Health Bars", meta = (AllowPrivateAccess = "true"))
+	float HealthBarHeight = 110.f;
+
+	// Anchors this far outside the view (pixels) still count as on screen so widgets don't pop at the edges
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Markers", meta = (AllowPrivateAccess = "true"))
+	float ScreenEdgeMargin = 50.f;
+
+	// Every widget this component has created, keeps them alive while they're collapsed
+	UPROPERTY(Transient)
+	TArray<UUserWidget*> CreatedWidgets;
+
+	UPROPERTY(Transient)
+	TArray<UHitNumberWidget*> FreeHitNumbers;
+
+	UPROPERTY(Transient)
+	TArray<UHealthBarWidget*> FreeHealthBars;
+
+	TArray<FHitNumberMarker> HitNumbers;
+	TArray<FHealthBarMarker> HealthBars;
+};
@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/UI/HUDOverlayWidget.h"
+#include "ProjectMarcus/PlayerController/ProjectMarcusPlayerController.h"
+#include "ProjectMarcus/UI/HUDViewModel.h"
+
+void UHUDOverlayWidget::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	const AProjectMarcusPlayerController* PC = Cast<AProjectMarcusPlayerController>(GetOwningPlayer());
+	ViewModel = PC ? PC->GetHUDViewModel() : nullptr;
+	if (ViewModel == nullptr)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UHUDOverlayWidget::NativeConstruct, %s has no HUD view model to bind"), *GetName());
+		return;
+	}
+
+	ViewModel->OnClipAmmoChanged.AddDynamic(this, &UHUDOverlayWidget::OnClipAmmoChanged);
+	ViewModel->OnStashAmmoChanged.AddDynamic(this, &UHUDOverlayWidget::OnStashAmmoChanged);
+	ViewModel->OnCrosshairSpreadChanged.AddDynamic(this, &UHUDOverlayWidget::OnCrosshairSpreadChanged);
+	ViewModel->OnEquippedSlotChanged.AddDynamic(this, &UHUDOverlayWidget::OnEquippedSlotChanged);
+	ViewModel->OnFocusedItemChanged.AddDynamic(this, &UHUDOverlayWidget::OnFocusedItemChanged);
+
+	// Events only fire on change, so start from what's there now
+	OnClipAmmoChanged(ViewModel->GetClipAmmo());
+	OnStashAmmoChanged(ViewModel->GetStashAmmo());
+	OnCrosshairSpreadChanged(ViewModel->GetCrosshairSpread());
+	OnEquippedSlotChanged(ViewModel->GetEquippedSlot());
+	OnFocusedItemChanged(ViewModel->GetFocusedItem());
+}
+
+void UHUDOverlayWidget::NativeDestruct()
+{
+	if (ViewModel)
+	{
+		ViewModel->OnClipAmmoChanged.RemoveAll(this);
+		ViewModel->OnStashAmmoChanged.RemoveAll(this);
+		ViewModel->OnCrosshairSpreadChanged.RemoveAll(this);
+		ViewModel->OnEquippedSlotChanged.RemoveAll(this);
+		ViewModel->OnFocusedItemChanged.RemoveAll(this);
+		ViewModel = nullptr;
+	}
+
+	Super::NativeDestruct();
+}
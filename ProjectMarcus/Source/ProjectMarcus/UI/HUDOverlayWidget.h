@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "HUDOverlayWidget.generated.h"
+
+class AItemBase;
+
+/**
+ * Base for the HUD overlay. Binds the owning players UHUDViewModel on construct and forwards each change to an event,
+ * after sending every current value once, so the blueprint only redraws what an event tells it about and never binds
+ * properties that are polled every frame.
+ */
+UCLASS(Abstract)
+class PROJECTMARCUS_API UHUDOverlayWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "HUD")
+	void OnClipAmmoChanged(int32 ClipAmmo);
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "HUD")
+	void OnStashAmmoChanged(int32 StashAmmo);
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "HUD")
+	void OnCrosshairSpreadChanged(float CrosshairSpread);
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "HUD")
+	void OnEquippedSlotChanged(int32 EquippedSlot);
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "HUD")
+	void OnFocusedItemChanged(AItemBase* FocusedItem);
+
+	UPROPERTY(BlueprintReadOnly, Category = "HUD")
+	class UHUDViewModel* ViewModel = nullptr;
+};
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/UI/HUDViewModel.h"
+#include "ProjectMarcus/PlayerController/ProjectMarcusPlayerController.h"
+#include "ProjectMarcus/Interactables/ItemBase.h"
+#include "ProjectMarcus/ProjectMarcus.h"
+#include "GameFramework/Pawn.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("HUD View Model Broadcasts"), STAT_HUDViewModelBroadcasts, STATGROUP_ProjectMarcus);
+
+UHUDViewModel* UHUDViewModel::Get(const APawn* Pawn)
+{
+	const AProjectMarcusPlayerController* PC = Pawn ? Cast<AProjectMarcusPlayerController>(Pawn->GetController()) : nullptr;
+	return PC ? PC->GetHUDViewModel() : nullptr;
+}
+
+void UHUDViewModel::SetClipAmmo(int32 InClipAmmo)
+{
+	if (ClipAmmo != InClipAmmo)
+	{
+		ClipAmmo = InClipAmmo;
+		OnClipAmmoChanged.Broadcast(ClipAmmo);
+		INC_DWORD_STAT(STAT_HUDViewModelBroadcasts);
+	}
+}
+
+void UHUDViewModel::SetStashAmmo(int32 InStashAmmo)
+{
+	if (StashAmmo != InStashAmmo)
+	{
+		StashAmmo = InStashAmmo;
+		OnStashAmmoChanged.Broadcast(StashAmmo);
+		INC_DWORD_STAT(STAT_HUDViewModelBroadcasts);
+	}
+}
+
+void UHUDViewModel::SetCrosshairSpread(float InCrosshairSpread)
+{
+	if (!FMath::IsNearlyEqual(CrosshairSpread, InCrosshairSpread, CrosshairSpreadTolerance))
+	{
+		CrosshairSpread = InCrosshairSpread;
+		OnCrosshairSpreadChanged.Broadcast(CrosshairSpread);
+		INC_DWORD_STAT(STAT_HUDViewModelBroadcasts);
+	}
+}
+
+void UHUDViewModel::SetEquippedSlot(int32 InEquippedSlot)
+{
+	if (EquippedSlot != InEquippedSlot)
+	{
+		EquippedSlot = InEquippedSlot;
+		OnEquippedSlotChanged.Broadcast(EquippedSlot);
+		INC_DWORD_STAT(STAT_HUDViewModelBroadcasts);
+	}
+}
+
+void UHUDViewModel::SetFocusedItem(AItemBase* InFocusedItem)
+{
+	if (FocusedItem.Get() != InFocusedItem)
+	{
+		FocusedItem = InFocusedItem;
+		OnFocusedItemChanged.Broadcast(InFocusedItem);
+		INC_DWORD_STAT(STAT_HUDViewModelBroadcasts);
+	}
+}
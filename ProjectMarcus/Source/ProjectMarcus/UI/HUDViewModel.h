@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "HUDViewModel.generated.h"
+
+class AItemBase;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHUDIntChangedDelegate, int32, NewValue);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHUDFloatChangedDelegate, float, NewValue);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHUDItemChangedDelegate, AItemBase*, NewItem);
+
+/**
+ * Everything the HUD overlay shows, pushed in by the character and the equipped weapon instead of polled by the widgets.
+ * Setting a field to the value it already has does nothing, so each event means the widget really has to redraw. Widgets
+ * read the getters once on construct, bind the events and can sit inside invalidation boxes since nothing changes them
+ * on frames without an event.
+ */
+UCLASS(BlueprintType)
+class PROJECTMARCUS_API UHUDViewModel : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// View model of the player controlling Pawn, nullptr for AI or an unpossessed pawn
+	static UHUDViewModel* Get(const APawn* Pawn);
+
+	void SetClipAmmo(int32 InClipAmmo);
+	void SetStashAmmo(int32 InStashAmmo);
+	void SetCrosshairSpread(float InCrosshairSpread);
+	void SetEquippedSlot(int32 InEquippedSlot);
+	void SetFocusedItem(AItemBase* InFocusedItem);
+
+	UFUNCTION(BlueprintPure, Category = "HUD")
+	int32 GetClipAmmo() const { return ClipAmmo; }
+
+	// Carried ammo of the equipped weapons type
+	UFUNCTION(BlueprintPure, Category = "HUD")
+	int32 GetStashAmmo() const { return StashAmmo; }
+
+	UFUNCTION(BlueprintPure, Category = "HUD")
+	float GetCrosshairSpread() const { return CrosshairSpread; }
+
+	UFUNCTION(BlueprintPure, Category = "HUD")
+	int32 GetEquippedSlot() const { return EquippedSlot; }
+
+	UFUNCTION(BlueprintPure, Category = "HUD")
+	AItemBase* GetFocusedItem() const { return FocusedItem.Get(); }
+
+	UPROPERTY(BlueprintAssignable, Category = "HUD")
+	FHUDIntChangedDelegate OnClipAmmoChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = "HUD")
+	FHUDIntChangedDelegate OnStashAmmoChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = "HUD")
+	FHUDFloatChangedDelegate OnCrosshairSpreadChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = "HUD")
+	FHUDIntChangedDelegate OnEquippedSlotChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = "HUD")
+	FHUDItemChangedDelegate OnFocusedItemChanged;
+
+private:
+	// Spread changes smaller than this aren't visible on the crosshair and aren't sent
+	UPROPERTY(EditAnywhere, Category = "HUD")
+	float CrosshairSpreadTolerance = 0.001f;
+
+	int32 ClipAmmo = 0;
+	int32 StashAmmo = 0;
+	float CrosshairSpread = 0.f;
+	int32 EquippedSlot = -1;
+	TWeakObjectPtr<AItemBase> FocusedItem;
+};
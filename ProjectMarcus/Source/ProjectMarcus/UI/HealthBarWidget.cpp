@@ -0,0 +1,12 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/UI/HealthBarWidget.h"
+
+void UHealthBarWidget::SetHealthPercent(float InHealthPercent)
+{
+	if (HealthPercent != InHealthPercent)
+	{
+		HealthPercent = InHealthPercent;
+		OnHealthPercentChanged(HealthPercent);
+	}
+}
@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "HealthBarWidget.generated.h"
+
+/**
+ * Health bar floating above an enemy. Pooled and positioned by UHUDMarkerComponent, the blueprint only handles the look.
+ */
+UCLASS(Abstract)
+class PROJECTMARCUS_API UHealthBarWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	void SetHealthPercent(float InHealthPercent);
+
+protected:
+	UFUNCTION(BlueprintImplementableEvent, Category = "Health Bar")
+	void OnHealthPercentChanged(float NewHealthPercent);
+
+	// 0-1
+	UPROPERTY(BlueprintReadOnly, Category = "Health Bar")
+	float HealthPercent = 1.f;
+};
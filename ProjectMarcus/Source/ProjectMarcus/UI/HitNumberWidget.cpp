@@ -0,0 +1,10 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectMarcus/UI/HitNumberWidget.h"
+
+void UHitNumberWidget::SetHitNumber(int32 InDamage, bool bInHeadshot)
+{
+	Damage = InDamage;
+	bHeadshot = bInHeadshot;
+	OnHitNumberChanged(Damage, bHeadshot);
+}
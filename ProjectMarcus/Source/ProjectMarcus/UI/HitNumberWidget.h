@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "HitNumberWidget.generated.h"
+
+/**
+ * Floating damage number. Pooled and positioned by UHUDMarkerComponent, the blueprint only handles the look.
+ */
+UCLASS(Abstract)
+class PROJECTMARCUS_API UHitNumberWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	void SetHitNumber(int32 InDamage, bool bInHeadshot);
+
+protected:
+	// Called whenever the number is (re)used or merged with another hit
+	UFUNCTION(BlueprintImplementableEvent, Category = "Hit Number")
+	void OnHitNumberChanged(int32 NewDamage, bool bNewHeadshot);
+
+	UPROPERTY(BlueprintReadOnly, Category = "Hit Number")
+	int32 Damage = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Hit Number")
+	bool bHeadshot = false;
+};